@@ -0,0 +1,329 @@
+// Measures load, build and query performance on a flight data CSV and prints
+// the results as a single JSON object, so runs can be diffed across versions.
+//
+// Generate large inputs with flight_gen; any file in the
+// FlightConnectionsJan2025.csv schema works.
+
+#include "../include/CompactGraph.h"
+#include "../include/CompressedGraph.h"
+#include "../include/Graph.h"
+#include "../include/fileio.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <sys/resource.h>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+  std::string flightData;
+  std::size_t queries = 1000;
+  std::size_t kQueries = 100;
+  std::uint64_t seed = 1;
+  std::string label = "unlabeled";
+};
+
+void print_usage() {
+  std::cout << "Usage: ./flight_bench --flight-data <flight_data_csv> "
+               "[--queries <count>] [--k-queries <count>] [--seed <seed>] "
+               "[--label <run_label>]"
+            << std::endl;
+}
+
+Options parse_options(int argc, char *argv[]) {
+  Options options;
+  for (int i = 1; i < argc; i++) {
+    std::string flag{argv[i]};
+    if (flag == "-h" || flag == "--help") {
+      print_usage();
+      exit(0);
+    }
+    if (i + 1 >= argc) {
+      throw std::runtime_error("Missing value for " + flag +
+                               "\nFor help, run ./flight_bench --help");
+    }
+    std::string value{argv[++i]};
+    if (flag == "--flight-data" || flag == "-f") {
+      options.flightData = value;
+    } else if (flag == "--queries") {
+      options.queries = std::stoull(value);
+    } else if (flag == "--k-queries") {
+      options.kQueries = std::stoull(value);
+    } else if (flag == "--seed") {
+      options.seed = std::stoull(value);
+    } else if (flag == "--label") {
+      options.label = value;
+    } else {
+      throw std::runtime_error("Unknown argument " + flag +
+                               "\nFor help, run ./flight_bench --help");
+    }
+  }
+  if (options.flightData.empty()) {
+    throw std::runtime_error("Please define --flight-data (flight data path)"
+                             "\nFor help, run ./flight_bench --help");
+  }
+  return options;
+}
+
+double elapsed_ms(Clock::time_point start, Clock::time_point end) {
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+long peak_rss_kb() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+// Quotes a string for JSON output, escaping quotes, backslashes and control
+// characters so arbitrary labels and file paths stay valid.
+std::string json_string(const std::string &value) {
+  std::string quoted = "\"";
+  for (char c : value) {
+    switch (c) {
+    case '"':
+      quoted += "\\\"";
+      break;
+    case '\\':
+      quoted += "\\\\";
+      break;
+    case '\n':
+      quoted += "\\n";
+      break;
+    case '\t':
+      quoted += "\\t";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20) {
+        char escaped[7];
+        std::snprintf(escaped, sizeof(escaped), "\\u%04x",
+                      static_cast<unsigned>(c));
+        quoted += escaped;
+      } else {
+        quoted += c;
+      }
+    }
+  }
+  return quoted + "\"";
+}
+
+struct LatencySummary {
+  double meanUs = 0;
+  double p50Us = 0;
+  double p99Us = 0;
+  std::size_t reachable = 0;
+};
+
+LatencySummary time_queries(
+    const std::vector<std::pair<std::string, std::string>> &pairs,
+    const std::function<unsigned long(const std::string &,
+                                      const std::string &,
+                                      std::vector<std::string> &)> &query) {
+  LatencySummary summary;
+  if (pairs.empty()) {
+    return summary;
+  }
+
+  std::vector<double> latencies;
+  latencies.reserve(pairs.size());
+  std::vector<std::string> path;
+
+  for (const auto &[from, to] : pairs) {
+    auto start = Clock::now();
+    unsigned long dist = query(from, to, path);
+    auto end = Clock::now();
+
+    latencies.push_back(std::chrono::duration<double, std::micro>(end - start)
+                            .count());
+    if (dist != std::numeric_limits<unsigned long>::max()) {
+      summary.reachable++;
+    }
+  }
+
+  std::sort(latencies.begin(), latencies.end());
+  double total = 0;
+  for (double latency : latencies) {
+    total += latency;
+  }
+  summary.meanUs = total / latencies.size();
+  summary.p50Us = latencies[(latencies.size() - 1) / 2];
+  summary.p99Us = latencies[(latencies.size() - 1) * 99 / 100];
+  return summary;
+}
+
+void print_latency(const std::string &engine, const LatencySummary &summary,
+                   bool last) {
+  std::cout << "    \"" << engine << "\": {\"mean_us\": " << summary.meanUs
+            << ", \"p50_us\": " << summary.p50Us
+            << ", \"p99_us\": " << summary.p99Us
+            << ", \"reachable\": " << summary.reachable << "}"
+            << (last ? "\n" : ",\n");
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  Options options;
+  try {
+    options = parse_options(argc, argv);
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+
+  try {
+    std::size_t rows = 0;
+    auto scan_start = Clock::now();
+    forEachFlightCSV(options.flightData,
+                     [&](const std::string &, const std::string &,
+                         unsigned long) { rows++; });
+    auto scan_end = Clock::now();
+
+    // loadFlightsCSV parses and builds in one pass; the build share is what
+    // remains after subtracting the parse-only scan above.
+    auto load_start = Clock::now();
+    Graph flight_graph = loadFlightsCSV(options.flightData);
+    auto load_end = Clock::now();
+    long graph_rss_kb = peak_rss_kb();
+
+    std::vector<std::string> labels;
+    labels.reserve(flight_graph.getVertices().size());
+    std::size_t edges = 0;
+    for (const auto &[label, vertex] : flight_graph.getVertices()) {
+      labels.push_back(label);
+      edges += vertex->edges.size();
+    }
+
+    auto compact_start = Clock::now();
+    AnyCompactGraph compact = makeCompactGraph(flight_graph);
+    auto compact_end = Clock::now();
+    AnyCompactGraph compact_hub_first =
+        makeCompactGraph(flight_graph, VertexOrder::HubFirst);
+    auto compact_hub_first_end = Clock::now();
+    AnyCompactGraph compact_rcm =
+        makeCompactGraph(flight_graph, VertexOrder::ReverseCuthillMcKee);
+    auto compact_rcm_end = Clock::now();
+    CompressedGraph compressed(flight_graph);
+    auto compressed_end = Clock::now();
+
+    std::vector<std::pair<std::string, std::string>> pairs;
+    if (!labels.empty()) {
+      std::mt19937_64 rng(options.seed);
+      std::uniform_int_distribution<std::size_t> pick(0, labels.size() - 1);
+      for (std::size_t i = 0; i < options.queries; i++) {
+        pairs.emplace_back(labels[pick(rng)], labels[pick(rng)]);
+      }
+    }
+
+    auto graph_latency = time_queries(
+        pairs, [&](const std::string &from, const std::string &to,
+                   std::vector<std::string> &path) {
+          return flight_graph.shortestPath(from, to, path);
+        });
+    auto compact_latency = time_queries(
+        pairs, [&](const std::string &from, const std::string &to,
+                   std::vector<std::string> &path) {
+          return compactShortestPath(compact, from, to, path);
+        });
+    auto compact_hub_first_latency = time_queries(
+        pairs, [&](const std::string &from, const std::string &to,
+                   std::vector<std::string> &path) {
+          return compactShortestPath(compact_hub_first, from, to, path);
+        });
+    auto compact_rcm_latency = time_queries(
+        pairs, [&](const std::string &from, const std::string &to,
+                   std::vector<std::string> &path) {
+          return compactShortestPath(compact_rcm, from, to, path);
+        });
+    auto compressed_latency = time_queries(
+        pairs, [&](const std::string &from, const std::string &to,
+                   std::vector<std::string> &path) {
+          return compressed.shortestPath(from, to, path);
+        });
+
+    // k shortest routes are much costlier, so they run on a prefix of the
+    // same pairs.
+    std::vector<std::pair<std::string, std::string>> k_pairs(
+        pairs.begin(), pairs.begin() + std::min(options.kQueries, pairs.size()));
+    const std::size_t k_values[] = {3, 5, 10, 20};
+    std::vector<LatencySummary> k_latencies;
+    SearchWorkspace workspace;
+    const Graph &shared_graph = flight_graph;
+    for (std::size_t k : k_values) {
+      k_latencies.push_back(time_queries(
+          k_pairs, [&](const std::string &from, const std::string &to,
+                       std::vector<std::string> &) {
+            auto routes = shared_graph.kShortestPaths(from, to, k, workspace);
+            return routes.empty() ? Graph::UNREACHABLE
+                                  : routes.back().distance;
+          }));
+    }
+
+    double csv_load_ms = elapsed_ms(scan_start, scan_end);
+    double load_total_ms = elapsed_ms(load_start, load_end);
+    auto compact_bytes = [](const AnyCompactGraph &graph) {
+      return std::visit([](const auto &g) { return g.memoryBytes(); }, graph);
+    };
+
+    std::cout << "{\n"
+              << "  \"label\": " << json_string(options.label) << ",\n"
+              << "  \"flight_data\": " << json_string(options.flightData)
+              << ",\n"
+              << "  \"rows\": " << rows << ",\n"
+              << "  \"vertices\": " << labels.size() << ",\n"
+              << "  \"edges\": " << edges << ",\n"
+              << "  \"queries\": " << pairs.size() << ",\n"
+              << "  \"seed\": " << options.seed << ",\n"
+              << "  \"csv_load_ms\": " << csv_load_ms << ",\n"
+              << "  \"graph_build_ms\": "
+              << std::max(0.0, load_total_ms - csv_load_ms) << ",\n"
+              << "  \"load_total_ms\": " << load_total_ms << ",\n"
+              << "  \"graph_peak_rss_kb\": " << graph_rss_kb << ",\n"
+              << "  \"compact_build_ms\": "
+              << elapsed_ms(compact_start, compact_end) << ",\n"
+              << "  \"compact_bytes\": " << compact_bytes(compact) << ",\n"
+              << "  \"compact_hub_first_build_ms\": "
+              << elapsed_ms(compact_end, compact_hub_first_end) << ",\n"
+              << "  \"compact_hub_first_bytes\": "
+              << compact_bytes(compact_hub_first) << ",\n"
+              << "  \"compact_rcm_build_ms\": "
+              << elapsed_ms(compact_hub_first_end, compact_rcm_end) << ",\n"
+              << "  \"compact_rcm_bytes\": " << compact_bytes(compact_rcm)
+              << ",\n"
+              << "  \"compressed_build_ms\": "
+              << elapsed_ms(compact_rcm_end, compressed_end) << ",\n"
+              << "  \"compressed_bytes\": " << compressed.memoryBytes() << ",\n"
+              << "  \"peak_rss_kb\": " << peak_rss_kb() << ",\n"
+              << "  \"shortest_path\": {\n";
+    print_latency("graph", graph_latency, false);
+    print_latency("compact", compact_latency, false);
+    print_latency("compact_hub_first", compact_hub_first_latency, false);
+    print_latency("compact_rcm", compact_rcm_latency, false);
+    print_latency("compressed", compressed_latency, true);
+    std::cout << "  },\n"
+              << "  \"k_queries\": " << k_pairs.size() << ",\n"
+              << "  \"k_shortest_paths\": {\n";
+    for (std::size_t i = 0; i < k_latencies.size(); i++) {
+      print_latency(std::to_string(k_values[i]), k_latencies[i],
+                    i + 1 == k_latencies.size());
+    }
+    std::cout << "  }\n"
+              << "}" << std::endl;
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,145 @@
+// Writes a synthetic flight network in the FlightConnectionsJan2025.csv schema.
+//
+// Airports are scattered over a continent-sized plane. Every flight has one
+// endpoint drawn from a heavy-tailed popularity distribution, so a few hubs
+// carry most of the connections and the rest are spokes, as in real networks.
+// Output is streamed, so row counts are limited only by disk.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Options {
+  std::uint64_t airports = 1000;
+  std::uint64_t rows = 10000;
+  std::uint64_t seed = 1;
+  double hubSkew = 3.0;
+  std::string output = "synthetic-flights.csv";
+};
+
+void print_usage() {
+  std::cout << "Usage: ./flight_gen [--airports <count>] [--rows <count>] "
+               "[--seed <seed>] [--hub-skew <exponent>] [--output <csv_path>]"
+            << std::endl;
+}
+
+Options parse_options(int argc, char *argv[]) {
+  Options options;
+  for (int i = 1; i < argc; i++) {
+    std::string flag{argv[i]};
+    if (flag == "-h" || flag == "--help") {
+      print_usage();
+      exit(0);
+    }
+    if (i + 1 >= argc) {
+      throw std::runtime_error("Missing value for " + flag +
+                               "\nFor help, run ./flight_gen --help");
+    }
+    std::string value{argv[++i]};
+    if (flag == "--airports") {
+      options.airports = std::stoull(value);
+    } else if (flag == "--rows") {
+      options.rows = std::stoull(value);
+    } else if (flag == "--seed") {
+      options.seed = std::stoull(value);
+    } else if (flag == "--hub-skew") {
+      options.hubSkew = std::stod(value);
+    } else if (flag == "--output") {
+      options.output = value;
+    } else {
+      throw std::runtime_error("Unknown argument " + flag +
+                               "\nFor help, run ./flight_gen --help");
+    }
+  }
+  if (options.airports < 2) {
+    throw std::runtime_error("At least two airports are required");
+  }
+  return options;
+}
+
+// Spells an airport index as uppercase letters, three of them while the
+// network fits in IATA-style codes and more once it does not.
+std::string airport_code(std::uint64_t index, int width) {
+  std::string code(width, 'A');
+  for (int i = width - 1; i >= 0; i--) {
+    code[i] = static_cast<char>('A' + index % 26);
+    index /= 26;
+  }
+  return code;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  Options options;
+  try {
+    options = parse_options(argc, argv);
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+
+  int width = 3;
+  for (std::uint64_t capacity = 26 * 26 * 26; capacity < options.airports;
+       capacity *= 26) {
+    width++;
+  }
+
+  std::mt19937_64 rng(options.seed);
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+  // Shuffle codes so hub rank is unrelated to alphabetical order.
+  std::vector<std::string> codes(options.airports);
+  std::vector<double> x(options.airports), y(options.airports);
+  for (std::uint64_t i = 0; i < options.airports; i++) {
+    codes[i] = airport_code(i, width);
+    x[i] = unit(rng) * 2500.0;
+    y[i] = unit(rng) * 1200.0;
+  }
+  std::shuffle(codes.begin(), codes.end(), rng);
+
+  std::ofstream out(options.output);
+  if (!out) {
+    std::cerr << "Failed to open " << options.output << " for writing\n";
+    return 1;
+  }
+
+  out << "ORIGIN,DEST,Average of ACTUAL_ELAPSED_TIME in Minutes,"
+         "CRS_ELAPSED_TIME in Minutes,DISTANCE in Miles\n";
+
+  std::uniform_int_distribution<std::uint64_t> any_airport(
+      0, options.airports - 1);
+  for (std::uint64_t row = 0; row < options.rows; row++) {
+    std::uint64_t hub = static_cast<std::uint64_t>(
+        std::pow(unit(rng), options.hubSkew) * options.airports);
+    std::uint64_t spoke = any_airport(rng);
+    while (spoke == hub) {
+      spoke = any_airport(rng);
+    }
+
+    std::uint64_t origin = hub, dest = spoke;
+    if (rng() & 1) {
+      std::swap(origin, dest);
+    }
+
+    double miles = std::hypot(x[origin] - x[dest], y[origin] - y[dest]);
+    unsigned long distance =
+        std::max(30UL, static_cast<unsigned long>(std::lround(miles)));
+    unsigned long scheduled = 30 + distance / 8;
+    unsigned long actual =
+        scheduled - scheduled / 10 + rng() % (scheduled / 5 + 1);
+
+    out << codes[origin] << ',' << codes[dest] << ',' << actual << ','
+        << scheduled << ',' << distance << '\n';
+  }
+
+  return 0;
+}
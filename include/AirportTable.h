@@ -0,0 +1,98 @@
+#ifndef AIRPORTTABLE_H
+#define AIRPORTTABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief A read-only index of airport codes and names backed by a mapped CSV file.
+ *
+ * The airports file is memory-mapped rather than parsed into strings. Three-letter
+ * IATA codes hash perfectly into a 26^3 slot table, where each slot records the
+ * byte offset of that airport's name in the mapped file. Checking a code is a
+ * single array lookup with no allocation, and a name is only located when it is
+ * actually requested.
+ */
+class AirportTable {
+public:
+    /**
+     * @brief The number of distinct three-letter uppercase codes.
+     */
+    static constexpr std::size_t SLOT_COUNT = 26 * 26 * 26;
+
+    /**
+     * @brief Maps the given airports CSV file and indexes its codes.
+     *
+     * Each line is expected to be `CODE,Airport Name`. Lines whose code is not
+     * three uppercase letters (such as the header) are skipped, and a code that
+     * appears more than once resolves to its last occurrence.
+     *
+     * @param file_path The path to the airports CSV file.
+     * @throws std::runtime_error if the file cannot be opened or mapped.
+     */
+    explicit AirportTable(const std::string &file_path);
+
+    /**
+     * @brief Unmaps the airports file.
+     */
+    ~AirportTable();
+
+    AirportTable(const AirportTable &) = delete;
+    AirportTable &operator=(const AirportTable &) = delete;
+
+    /**
+     * @brief Moves a table, taking over its mapping.
+     */
+    AirportTable(AirportTable &&other) noexcept;
+
+    AirportTable &operator=(AirportTable &&) = delete;
+
+    /**
+     * @brief Computes the perfect-hash slot of an airport code.
+     * @param code The airport code to hash.
+     * @return long The slot index, or -1 if the code is not three uppercase letters.
+     */
+    static constexpr long slot(std::string_view code) {
+        if (code.size() != 3) {
+            return -1;
+        }
+        long index = 0;
+        for (char c : code) {
+            if (c < 'A' || c > 'Z') {
+                return -1;
+            }
+            index = index * 26 + (c - 'A');
+        }
+        return index;
+    }
+
+    /**
+     * @brief Checks whether an airport code is present in the table.
+     * @param code The IATA code to look up.
+     * @return bool True if the airport is known, false otherwise.
+     */
+    bool contains(std::string_view code) const;
+
+    /**
+     * @brief Resolves the name of an airport.
+     *
+     * The returned view points into the mapped file and stays valid for the
+     * lifetime of the table.
+     *
+     * @param code The IATA code to look up.
+     * @return std::string_view The airport's name, or an empty view if unknown.
+     */
+    std::string_view name(std::string_view code) const;
+
+private:
+    const char *data = nullptr;
+    std::size_t size = 0;
+
+    // Offset of each airport's name plus one; zero marks an empty slot.
+    std::vector<std::uint32_t> nameOffsets;
+};
+
+#endif
@@ -0,0 +1,440 @@
+#ifndef COMPACTGRAPH_H
+#define COMPACTGRAPH_H
+
+#include "Graph.h"
+#include "PriorityQueue.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+/**
+ * @brief Metric policy that weighs each flight by its distance.
+ */
+struct DistanceMetric {
+    template <typename W> static constexpr W cost(W weight) { return weight; }
+};
+
+/**
+ * @brief Metric policy that weighs every flight equally, minimizing the number
+ * of legs.
+ */
+struct HopMetric {
+    template <typename W> static constexpr W cost(W) { return 1; }
+};
+
+/**
+ * @brief The order in which a CompactGraph numbers its vertices.
+ *
+ * Dijkstra touches a settled vertex's neighbors back to back, so numbering
+ * neighbors close together keeps their distance slots and adjacency rows on
+ * the same cache lines.
+ */
+enum class VertexOrder {
+    /** Alphabetical by label, as Graph stores them. */
+    Label,
+    /** Highest degree first, so hubs share the front of every array. */
+    HubFirst,
+    /** Reverse Cuthill-McKee, a breadth-first order that keeps neighbors close. */
+    ReverseCuthillMcKee
+};
+
+/**
+ * @brief A read-only, compactly stored snapshot of a Graph for fast queries.
+ *
+ * Vertices are renumbered to dense ids and the adjacency is laid out in
+ * compressed sparse row form: one offsets array and parallel arrays of target
+ * ids and weights. The weight and id widths are chosen at compile time, so a
+ * network whose mileage fits in 16 bits and whose airport count fits in 16 bits
+ * stores each edge in 4 bytes instead of a list node with a string.
+ *
+ * Path lengths are accumulated in a type at least as wide as the weight and id
+ * types combined. A simple path has fewer than 2^idbits edges of less than
+ * 2^weightbits each, so the sum cannot overflow.
+ *
+ * @tparam Weight An unsigned integer type holding a single flight's weight.
+ * @tparam VertexId An unsigned integer type holding a vertex id.
+ * @tparam Metric A policy providing `cost(weight)` for each flight.
+ */
+template <typename Weight, typename VertexId, typename Metric = DistanceMetric>
+class CompactGraph {
+    static_assert(std::is_unsigned_v<Weight> && std::is_unsigned_v<VertexId>,
+                  "CompactGraph requires unsigned weight and id types");
+    static_assert(sizeof(Weight) + sizeof(VertexId) <= sizeof(std::uint64_t),
+                  "weight and id widths must fit a 64-bit accumulator");
+
+public:
+    using weight_type = Weight;
+    using vertex_id = VertexId;
+    using distance_type =
+        std::conditional_t<sizeof(Weight) + sizeof(VertexId) <=
+                               sizeof(std::uint32_t),
+                           std::uint32_t, std::uint64_t>;
+
+    /**
+     * @brief Checks whether a graph's ranges fit this specialization.
+     * @param vertexCount The number of vertices in the graph.
+     * @param maxWeight The largest edge weight in the graph.
+     * @return bool True if every id and weight is representable.
+     */
+    static bool fits(std::size_t vertexCount, unsigned long maxWeight) {
+        return vertexCount <= std::numeric_limits<VertexId>::max() &&
+               maxWeight <= std::numeric_limits<Weight>::max();
+    }
+
+    /**
+     * @brief Builds a compact snapshot of a graph.
+     *
+     * Vertex ids follow the requested order. Labels are still looked up and
+     * reported as before, so the order only changes the memory layout.
+     *
+     * @param graph The graph to snapshot.
+     * @param order The vertex numbering to use.
+     * @throws std::runtime_error if the graph does not fit this specialization.
+     */
+    explicit CompactGraph(const Graph &graph,
+                          VertexOrder order = VertexOrder::Label) {
+        const auto &vertices = graph.getVertices();
+
+        std::unordered_map<const Graph::Vertex *, VertexId> ids;
+        ids.reserve(vertices.size());
+        labels.reserve(vertices.size());
+        std::size_t edgeTotal = 0;
+        for (const auto &[label, vertex] : vertices) {
+            ids.emplace(vertex, static_cast<VertexId>(labels.size()));
+            labels.push_back(label);
+            edgeTotal += vertex->edges.size();
+        }
+
+        if (vertices.size() > std::numeric_limits<VertexId>::max() ||
+            edgeTotal > std::numeric_limits<std::uint32_t>::max()) {
+            throw std::runtime_error("Graph is too large for this layout");
+        }
+
+        offsets.reserve(vertices.size() + 1);
+        targets.reserve(edgeTotal);
+        weights.reserve(edgeTotal);
+        offsets.push_back(0);
+        for (const auto &[label, vertex] : vertices) {
+            for (const auto &edge : vertex->edges) {
+                if (edge.distance > std::numeric_limits<Weight>::max()) {
+                    throw std::runtime_error(
+                        "Flight distance is too large for this layout");
+                }
+                targets.push_back(ids.at(edge.destination));
+                weights.push_back(static_cast<Weight>(edge.distance));
+            }
+            offsets.push_back(static_cast<std::uint32_t>(targets.size()));
+        }
+
+        byLabel.resize(labels.size());
+        std::iota(byLabel.begin(), byLabel.end(), VertexId(0));
+
+        if (order == VertexOrder::HubFirst) {
+            renumber(hubFirstOrder());
+        } else if (order == VertexOrder::ReverseCuthillMcKee) {
+            renumber(reverseCuthillMcKeeOrder());
+        }
+    }
+
+    /**
+     * @brief Gets the number of vertices.
+     * @return std::size_t The vertex count.
+     */
+    std::size_t vertexCount() const { return labels.size(); }
+
+    /**
+     * @brief Gets the number of stored (directed) edges.
+     * @return std::size_t The edge count.
+     */
+    std::size_t edgeCount() const { return targets.size(); }
+
+    /**
+     * @brief Gets the number of bytes used by the adjacency arrays.
+     * @return std::size_t The adjacency footprint, excluding labels.
+     */
+    std::size_t memoryBytes() const {
+        return offsets.size() * sizeof(std::uint32_t) +
+               targets.size() * sizeof(VertexId) +
+               weights.size() * sizeof(Weight) +
+               byLabel.size() * sizeof(VertexId);
+    }
+
+    /**
+     * @brief Looks up the id of a vertex.
+     * @param label The vertex label.
+     * @return long The vertex id, or -1 if the label is unknown.
+     */
+    long findVertex(const std::string &label) const {
+        auto it = std::lower_bound(
+            byLabel.begin(), byLabel.end(), label,
+            [this](VertexId id, const std::string &l) { return labels[id] < l; });
+        if (it == byLabel.end() || labels[*it] != label) {
+            return -1;
+        }
+        return static_cast<long>(*it);
+    }
+
+    /**
+     * @brief Gets the label of a vertex.
+     * @param id The vertex id.
+     * @return const std::string& The vertex label.
+     */
+    const std::string &label(VertexId id) const { return labels[id]; }
+
+    /**
+     * @brief Finds the shortest path between two vertices using Dijkstra's algorithm.
+     * @param startLabel The label of the starting vertex.
+     * @param endLabel The label of the destination vertex.
+     * @param path A vector of strings to be populated with the labels on the path.
+     * @return unsigned long The total cost of the path under the metric. Returns
+     *         std::numeric_limits<unsigned long>::max() if no path is found.
+     */
+    unsigned long shortestPath(const std::string &startLabel,
+                               const std::string &endLabel,
+                               std::vector<std::string> &path) const {
+        path.clear();
+
+        long start = findVertex(startLabel);
+        long end = findVertex(endLabel);
+        if (start < 0 || end < 0) {
+            return std::numeric_limits<unsigned long>::max();
+        }
+
+        const distance_type infinity =
+            std::numeric_limits<distance_type>::max();
+        std::vector<distance_type> distances(labels.size(), infinity);
+        std::vector<VertexId> previous(labels.size());
+
+        distances[start] = 0;
+
+        PriorityQueue<Node> pq;
+        pq.push({0, static_cast<VertexId>(start)});
+
+        while (!pq.isEmpty()) {
+            Node current = pq.top();
+            pq.pop();
+
+            VertexId u = current.vertex;
+            if (current.distance > distances[u]) {
+                continue;
+            }
+
+            if (u == static_cast<VertexId>(end)) {
+                break;
+            }
+
+            for (std::uint32_t i = offsets[u]; i < offsets[u + 1]; i++) {
+                VertexId v = targets[i];
+                distance_type candidate =
+                    distances[u] + Metric::cost(weights[i]);
+
+                if (candidate < distances[v]) {
+                    distances[v] = candidate;
+                    previous[v] = u;
+                    pq.push({candidate, v});
+                }
+            }
+        }
+
+        if (distances[end] == infinity) {
+            return std::numeric_limits<unsigned long>::max();
+        }
+
+        for (VertexId curr = static_cast<VertexId>(end);;
+             curr = previous[curr]) {
+            path.push_back(labels[curr]);
+            if (curr == static_cast<VertexId>(start)) {
+                break;
+            }
+        }
+        std::reverse(path.begin(), path.end());
+
+        return static_cast<unsigned long>(distances[end]);
+    }
+
+private:
+    struct Node {
+        distance_type distance;
+        VertexId vertex;
+
+        bool operator<(const Node &other) const {
+            return distance < other.distance;
+        }
+
+        bool operator>(const Node &other) const {
+            return distance > other.distance;
+        }
+    };
+
+    std::vector<std::string> labels;
+    std::vector<std::uint32_t> offsets;
+    std::vector<VertexId> targets;
+    std::vector<Weight> weights;
+
+    // Vertex ids sorted by label, for lookups independent of the numbering.
+    std::vector<VertexId> byLabel;
+
+    std::uint32_t degree(VertexId v) const { return offsets[v + 1] - offsets[v]; }
+
+    /**
+     * @brief Orders vertices by descending degree, breaking ties by label.
+     * @return std::vector<VertexId> The old id of each vertex in its new position.
+     */
+    std::vector<VertexId> hubFirstOrder() const {
+        std::vector<VertexId> order(labels.size());
+        std::iota(order.begin(), order.end(), VertexId(0));
+        std::stable_sort(order.begin(), order.end(), [this](VertexId a, VertexId b) {
+            return degree(a) > degree(b);
+        });
+        return order;
+    }
+
+    /**
+     * @brief Orders vertices by reverse Cuthill-McKee.
+     *
+     * Each component is traversed breadth-first from its lowest-degree vertex,
+     * enqueueing neighbors by ascending degree, and the whole sequence is
+     * reversed.
+     *
+     * @return std::vector<VertexId> The old id of each vertex in its new position.
+     */
+    std::vector<VertexId> reverseCuthillMcKeeOrder() const {
+        std::vector<VertexId> byDegree(labels.size());
+        std::iota(byDegree.begin(), byDegree.end(), VertexId(0));
+        std::stable_sort(byDegree.begin(), byDegree.end(),
+                         [this](VertexId a, VertexId b) {
+                             return degree(a) < degree(b);
+                         });
+
+        std::vector<VertexId> order;
+        order.reserve(labels.size());
+        std::vector<bool> visited(labels.size(), false);
+        std::vector<VertexId> neighbors;
+
+        for (VertexId root : byDegree) {
+            if (visited[root]) {
+                continue;
+            }
+            visited[root] = true;
+            std::size_t head = order.size();
+            order.push_back(root);
+
+            while (head < order.size()) {
+                VertexId u = order[head++];
+                neighbors.clear();
+                for (std::uint32_t i = offsets[u]; i < offsets[u + 1]; i++) {
+                    if (!visited[targets[i]]) {
+                        visited[targets[i]] = true;
+                        neighbors.push_back(targets[i]);
+                    }
+                }
+                std::stable_sort(neighbors.begin(), neighbors.end(),
+                                 [this](VertexId a, VertexId b) {
+                                     return degree(a) < degree(b);
+                                 });
+                order.insert(order.end(), neighbors.begin(), neighbors.end());
+            }
+        }
+
+        std::reverse(order.begin(), order.end());
+        return order;
+    }
+
+    /**
+     * @brief Renumbers every vertex and permutes the adjacency to match.
+     *
+     * Each vertex's neighbors are also sorted by their new id so a relaxation
+     * scan walks the distance array forwards.
+     *
+     * @param order The old id of each vertex in its new position.
+     */
+    void renumber(const std::vector<VertexId> &order) {
+        std::vector<VertexId> rank(order.size());
+        for (std::size_t i = 0; i < order.size(); i++) {
+            rank[order[i]] = static_cast<VertexId>(i);
+        }
+
+        std::vector<std::string> newLabels;
+        std::vector<std::uint32_t> newOffsets;
+        std::vector<VertexId> newTargets;
+        std::vector<Weight> newWeights;
+        std::vector<std::pair<VertexId, Weight>> row;
+
+        newLabels.reserve(labels.size());
+        newOffsets.reserve(offsets.size());
+        newTargets.reserve(targets.size());
+        newWeights.reserve(weights.size());
+        newOffsets.push_back(0);
+
+        for (VertexId old : order) {
+            newLabels.push_back(std::move(labels[old]));
+
+            row.clear();
+            for (std::uint32_t i = offsets[old]; i < offsets[old + 1]; i++) {
+                row.emplace_back(rank[targets[i]], weights[i]);
+            }
+            std::sort(row.begin(), row.end());
+            for (const auto &[target, weight] : row) {
+                newTargets.push_back(target);
+                newWeights.push_back(weight);
+            }
+            newOffsets.push_back(static_cast<std::uint32_t>(newTargets.size()));
+        }
+
+        for (auto &id : byLabel) {
+            id = rank[id];
+        }
+
+        labels = std::move(newLabels);
+        offsets = std::move(newOffsets);
+        targets = std::move(newTargets);
+        weights = std::move(newWeights);
+    }
+};
+
+/**
+ * @brief A compact graph in whichever specialization fits the loaded data.
+ */
+using AnyCompactGraph =
+    std::variant<CompactGraph<std::uint16_t, std::uint16_t>,
+                 CompactGraph<std::uint16_t, std::uint32_t>,
+                 CompactGraph<std::uint32_t, std::uint16_t>,
+                 CompactGraph<std::uint32_t, std::uint32_t>>;
+
+/**
+ * @brief Builds the narrowest compact snapshot that can hold a graph.
+ *
+ * The graph's vertex count and largest flight distance pick the weight and id
+ * widths, preferring 16-bit over 32-bit for each.
+ *
+ * @param graph The graph to snapshot.
+ * @param order The vertex numbering to use.
+ * @return AnyCompactGraph The compact snapshot.
+ * @throws std::runtime_error if the graph exceeds 32-bit weights or ids.
+ */
+AnyCompactGraph makeCompactGraph(const Graph &graph,
+                                 VertexOrder order = VertexOrder::Label);
+
+/**
+ * @brief Finds the shortest path in a compact snapshot of any specialization.
+ * @param graph The compact snapshot to search.
+ * @param startLabel The label of the starting vertex.
+ * @param endLabel The label of the destination vertex.
+ * @param path A vector of strings to be populated with the labels on the path.
+ * @return unsigned long The total distance of the path, or
+ *         std::numeric_limits<unsigned long>::max() if no path is found.
+ */
+unsigned long compactShortestPath(const AnyCompactGraph &graph,
+                                  const std::string &startLabel,
+                                  const std::string &endLabel,
+                                  std::vector<std::string> &path);
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef COMPRESSEDGRAPH_H
+#define COMPRESSEDGRAPH_H
+
+#include "Graph.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A read-only snapshot of a Graph with varint-compressed adjacency.
+ *
+ * Vertices are numbered in label order. Each vertex's row holds its degree
+ * followed by (neighbor, weight) pairs sorted by neighbor id. The first
+ * neighbor is stored as a zigzag difference from the vertex's own id, each
+ * later one as the gap from the previous neighbor, and each weight as-is, all
+ * in LEB128 varints. A typical flight then takes two or three bytes instead of
+ * the four to eight of an uncompressed CompactGraph edge, at the cost of
+ * decoding rows during the search.
+ */
+class CompressedGraph {
+public:
+    /**
+     * @brief Builds a compressed snapshot of a graph.
+     * @param graph The graph to snapshot.
+     */
+    explicit CompressedGraph(const Graph &graph);
+
+    /**
+     * @brief Gets the number of vertices.
+     * @return std::size_t The vertex count.
+     */
+    std::size_t vertexCount() const { return labels.size(); }
+
+    /**
+     * @brief Gets the number of stored (directed) edges.
+     * @return std::size_t The edge count.
+     */
+    std::size_t edgeCount() const { return edges; }
+
+    /**
+     * @brief Gets the number of bytes used by the encoded rows and row offsets.
+     * @return std::size_t The adjacency footprint, excluding labels.
+     */
+    std::size_t memoryBytes() const {
+        return bytes.size() + rowOffsets.size() * sizeof(std::uint32_t);
+    }
+
+    /**
+     * @brief Looks up the id of a vertex.
+     * @param label The vertex label.
+     * @return long The vertex id, or -1 if the label is unknown.
+     */
+    long findVertex(const std::string &label) const;
+
+    /**
+     * @brief Gets the label of a vertex.
+     * @param id The vertex id.
+     * @return const std::string& The vertex label.
+     */
+    const std::string &label(std::uint32_t id) const { return labels[id]; }
+
+    /**
+     * @brief Finds the shortest path between two vertices, decoding rows as
+     * they are settled.
+     * @param startLabel The label of the starting vertex.
+     * @param endLabel The label of the destination vertex.
+     * @param path A vector of strings to be populated with the labels on the path.
+     * @return unsigned long The total distance of the path. Returns
+     *         std::numeric_limits<unsigned long>::max() if no path is found.
+     */
+    unsigned long shortestPath(const std::string &startLabel,
+                               const std::string &endLabel,
+                               std::vector<std::string> &path) const;
+
+private:
+    std::vector<std::string> labels;
+    std::vector<std::uint32_t> rowOffsets;
+    std::vector<std::uint8_t> bytes;
+    std::size_t edges = 0;
+};
+
+#endif
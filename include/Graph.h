@@ -2,9 +2,13 @@
 #define GRAPH_H
 
 #include "GraphBase.h"
+#include "SearchStats.h"
+#include "SearchWorkspace.h"
 #include <limits>
 #include <list>
 #include <map>
+#include <memory>
+#include <memory_resource>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -16,33 +20,46 @@
  * and edges represent flights between them. It supports operations such as adding
  * and removing airports and flights, as well as finding the shortest path between
  * two airports using Dijkstra's algorithm.
+ *
+ * Vertices, edge nodes and the label index are carved out of a pool resource
+ * owned by the graph rather than allocated individually on the heap. Freed
+ * vertices and edges go back to the pool's free lists and are reused by later
+ * insertions, and the whole pool is released in one step when the graph is
+ * cleared.
  */
 class Graph : public GraphBase {
 public:
+    struct Vertex;
+
     /**
      * @brief Represents a flight between two airports.
      *
      * An Edge connects two vertices (airports) in the graph, representing a flight
-     * route. It contains the destination airport's label and the distance of
-     * the flight.
+     * route. It points at the destination airport's vertex and holds the
+     * distance of the flight; the destination's label is read through it.
+     *
+     * Every flight is stored once on each endpoint. Each copy points at the
+     * destination vertex and at its twin in the destination's edge list, so
+     * either copy can unlink both in constant time.
      */
     struct Edge {
-        std::string destinationLabel;
         unsigned long distance;
+        Vertex *destination;
+        std::pmr::list<Edge>::iterator twin;
 
         /**
          * @brief Constructs a new Edge.
-         * @param dest The label of the destination airport.
+         * @param dest The destination airport's vertex.
          * @param dis The distance of the flight.
          */
-        Edge(std::string dest, unsigned long dis)
-            : destinationLabel(dest), distance(dis) {}
+        Edge(Vertex *dest, unsigned long dis)
+            : distance(dis), destination(dest) {}
 
         /**
          * @brief Gets the label of the destination airport.
          * @return std::string The destination airport's label.
          */
-        std::string getDestinationLabel() const { return destinationLabel; }
+        std::string getDestinationLabel() const;
 
         /**
          * @brief Gets the distance of the flight.
@@ -51,6 +68,14 @@ public:
         unsigned long getDistance() const { return distance; }
     };
 
+    /**
+     * @brief A route between two airports and its total distance.
+     */
+    struct Route {
+        unsigned long distance = 0;
+        std::vector<std::string> airports;
+    };
+
     /**
      * @brief Represents an airport in the graph.
      *
@@ -60,13 +85,24 @@ public:
      */
     struct Vertex {
         std::string label;
-        std::list<Edge> edges;
+        std::pmr::list<Edge> edges;
+
+        // Dense index assigned by the graph, used to address search state.
+        std::size_t id = 0;
+
+        // Union-find links for the connected-component index.
+        Vertex *componentParent = this;
+        unsigned int componentRank = 0;
 
         /**
          * @brief Constructs a new Vertex.
          * @param l The label of the airport (e.g., IATA code).
+         * @param resource The memory resource the edge list allocates from.
          */
-        Vertex(std::string l) : label(l) {}
+        Vertex(std::string l,
+               std::pmr::memory_resource *resource =
+                   std::pmr::get_default_resource())
+            : label(l), edges(resource) {}
 
         /**
          * @brief Gets the label of the airport.
@@ -76,30 +112,141 @@ public:
 
         /**
          * @brief Gets the list of outgoing flights (edges) from this airport.
-         * @return const std::list<Edge>& A constant reference to the list of edges.
+         * @return const std::pmr::list<Edge>& A constant reference to the list of edges.
          */
-        const std::list<Edge> &getEdges() const { return edges; }
+        const std::pmr::list<Edge> &getEdges() const { return edges; }
     };
 
 private:
-    std::map<std::string, Vertex *> vertices;
+    using VertexIndex = std::pmr::map<std::string, Vertex *>;
+
+    // Declared before `vertices` so the pool outlives every vertex in it. The
+    // index's nodes come from the same pool as the vertices.
+    std::unique_ptr<std::pmr::unsynchronized_pool_resource> pool;
+    VertexIndex vertices;
+
+    // Vertices indexed by id. Ids of removed vertices are recycled through
+    // freeIds so the table stays dense.
+    std::vector<Vertex *> verticesById;
+    std::vector<std::size_t> freeIds;
+
+    // Search state reused by the non-const shortestPath and kShortestPaths
+    // overloads. Named apart from the workspace parameters of the const
+    // overloads so the two are never confused.
+    SearchWorkspace ownWorkspace;
+
+    // Removals can split a component, which union-find cannot undo, so they
+    // only mark the index stale and the next query rebuilds it.
+    bool componentsStale = false;
+
+    // Set once a label outgrows the small-string buffer and spills onto the
+    // global heap. Until then every byte the graph owns is in the pool, and
+    // clearing can release it without visiting each vertex.
+    bool heapLabels = false;
 
     /**
      * @brief Clears the graph, deallocating all vertices.
      */
     void clearGraph();
 
+    /**
+     * @brief Finds the representative of a vertex's connected component.
+     *
+     * Union by rank keeps trees O(log V) deep, so the lookup does not need to
+     * compress paths and leaves the index untouched.
+     *
+     * @param v The vertex to look up.
+     * @return Vertex* The component's representative vertex.
+     */
+    static Vertex *findComponent(Vertex *v);
+
+    /**
+     * @brief Merges the connected components of two vertices.
+     * @param a A vertex in the first component.
+     * @param b A vertex in the second component.
+     */
+    static void unionComponents(Vertex *a, Vertex *b);
+
+    /**
+     * @brief Recomputes the connected-component index from every edge.
+     */
+    void rebuildComponents();
+
+    /**
+     * @brief Runs Dijkstra's algorithm over vertex ids in a workspace.
+     *
+     * Vertices and edges masked in the workspace are skipped. When guided, the
+     * workspace's potentials must be distances to `end`; they turn the search
+     * into A* and prune every vertex that cannot reach `end`.
+     *
+     * @param start The id of the starting vertex.
+     * @param end The id of the destination, or an id past vertexIdBound() to
+     *        settle every reachable vertex.
+     * @param workspace The search state to use.
+     * @param guided Whether to use the workspace's potentials.
+     * @param stats Counters to add this search's work to, or nullptr.
+     * @return unsigned long The distance to `end`, or SearchWorkspace::INFINITE.
+     */
+    unsigned long search(std::size_t start, std::size_t end,
+                         SearchWorkspace &workspace, bool guided,
+                         SearchStats *stats) const;
+
+    /**
+     * @brief Constructs a vertex in the graph's pool.
+     * @param label The label of the airport.
+     * @return Vertex* The newly constructed vertex.
+     */
+    Vertex *createVertex(std::string label);
+
+    /**
+     * @brief Destroys a vertex and returns its storage to the pool.
+     * @param v The vertex to destroy.
+     */
+    void destroyVertex(Vertex *v);
+
 public:
     /**
-     * @brief Constructs an empty Graph.
+     * @brief The distance reported for a pair of airports with no route between them.
+     */
+    static constexpr unsigned long UNREACHABLE =
+        std::numeric_limits<unsigned long>::max();
+
+    /**
+     * @brief Constructs an empty Graph backed by the default heap resource.
      */
     Graph();
 
+    /**
+     * @brief Constructs an empty Graph whose pool draws its chunks from the
+     * given resource.
+     *
+     * Pass a std::pmr::monotonic_buffer_resource to build the whole graph in a
+     * single arena. The resource must outlive the graph.
+     *
+     * @param upstream The resource the graph's pool allocates chunks from.
+     */
+    explicit Graph(std::pmr::memory_resource *upstream);
+
     /**
      * @brief Destroys the Graph, freeing all allocated memory.
      */
     ~Graph();
 
+    Graph(const Graph &) = delete;
+    Graph &operator=(const Graph &) = delete;
+
+    /**
+     * @brief Moves a graph, taking over its pool and vertices.
+     *
+     * The moved-from graph is left empty and may only be destroyed or assigned to.
+     */
+    Graph(Graph &&other) noexcept;
+
+    /**
+     * @brief Move-assigns a graph, releasing this graph's vertices first.
+     */
+    Graph &operator=(Graph &&other) noexcept;
+
     /**
      * @brief Adds an airport (vertex) to the graph.
      * @param label The IATA code or label for the airport.
@@ -108,10 +255,24 @@ public:
 
     /**
      * @brief Removes an airport (vertex) from the graph.
+     *
+     * Only the airport's own flights are visited, so this costs O(log V + degree).
+     *
      * @param label The IATA code or label of the airport to remove.
      */
     void removeVertex(std::string label) override;
 
+    /**
+     * @brief Removes several airports (vertices) from the graph at once.
+     *
+     * Costs O(k log V + d) expected, where d is the total degree of the
+     * removed airports: membership is checked in a hash set. Flights between
+     * two removed airports are dropped without unlinking them individually.
+     *
+     * @param labels The IATA codes or labels of the airports to remove.
+     */
+    void removeVertices(const std::vector<std::string> &labels);
+
     /**
      * @brief Adds a flight (edge) between two airports.
      * @param label1 The label of the starting airport.
@@ -123,26 +284,123 @@ public:
 
     /**
      * @brief Removes a flight (edge) between two airports.
+     *
+     * Scans the edge list of whichever airport has fewer flights.
+     *
      * @param label1 The label of the starting airport.
      * @param label2 The label of the destination airport.
      */
     void removeEdge(std::string label1, std::string label2) override;
 
+    /**
+     * @brief Gets one more than the largest vertex id in use.
+     *
+     * Every vertex's id is below this bound, so it sizes arrays indexed by id.
+     *
+     * @return std::size_t The vertex id bound.
+     */
+    std::size_t vertexIdBound() const { return verticesById.size(); }
+
+    /**
+     * @brief Checks whether any route connects two airports.
+     *
+     * Answered from the connected-component index in O(log V), without a search.
+     *
+     * @param label1 The label of the first airport.
+     * @param label2 The label of the second airport.
+     * @return bool True if both airports exist and a route joins them.
+     */
+    bool connected(std::string label1, std::string label2);
+
     /**
      * @brief Finds the shortest flight path between two airports using Dijkstra's algorithm.
+     *
+     * Airports in different connected components are rejected before searching.
+     *
      * @param startLabel The label of the starting airport.
      * @param endLabel The label of the destination airport.
      * @param path A vector of strings to be populated with the labels of the airports in the shortest path.
-     * @return unsigned long The total distance of the shortest path. Returns std::numeric_limits<unsigned long>::max() if no path is found.
+     * @return unsigned long The total distance of the shortest path. Returns UNREACHABLE if no path is found.
      */
     unsigned long shortestPath(std::string startLabel, std::string endLabel,
                                std::vector<std::string> &path) override;
 
+    /**
+     * @brief Finds the shortest flight path, recording how much work the search did.
+     * @param startLabel The label of the starting airport.
+     * @param endLabel The label of the destination airport.
+     * @param path A vector of strings to be populated with the labels of the airports in the shortest path.
+     * @param stats Counters to add this search's work to, or nullptr to skip counting.
+     * @return unsigned long The total distance of the shortest path. Returns UNREACHABLE if no path is found.
+     */
+    unsigned long shortestPath(std::string startLabel, std::string endLabel,
+                               std::vector<std::string> &path,
+                               SearchStats *stats);
+
+    /**
+     * @brief Finds the shortest flight path using caller-owned search state.
+     *
+     * This overload does not modify the graph, so any number of threads can
+     * query the same graph at once as long as each uses its own workspace and
+     * nothing mutates the graph meanwhile. Reusing a workspace makes the setup
+     * cost of each query independent of the network size. If flights were
+     * removed since the component index was last rebuilt, the index is not
+     * consulted and unreachable pairs are found by searching.
+     *
+     * Vertices and edges masked in the workspace are skipped.
+     *
+     * @param startLabel The label of the starting airport.
+     * @param endLabel The label of the destination airport.
+     * @param path A vector of strings to be populated with the labels of the airports in the shortest path.
+     * @param workspace The search state to use for this query.
+     * @param stats Counters to add this search's work to, or nullptr to skip counting.
+     * @return unsigned long The total distance of the shortest path. Returns UNREACHABLE if no path is found.
+     */
+    unsigned long shortestPath(std::string startLabel, std::string endLabel,
+                               std::vector<std::string> &path,
+                               SearchWorkspace &workspace,
+                               SearchStats *stats = nullptr) const;
+
+    /**
+     * @brief Finds up to k shortest loopless routes between two airports.
+     * @param startLabel The label of the starting airport.
+     * @param endLabel The label of the destination airport.
+     * @param k The maximum number of routes to return.
+     * @return std::vector<Route> The routes, shortest first.
+     */
+    std::vector<Route> kShortestPaths(std::string startLabel,
+                                      std::string endLabel, std::size_t k);
+
+    /**
+     * @brief Finds up to k shortest loopless routes using caller-owned search state.
+     *
+     * This is Yen's algorithm, run entirely inside the workspace: each spur search
+     * masks the root path's vertices and the edges already taken from the spur,
+     * and the graph itself is never modified. A route only spurs from the point
+     * where it left the route it was derived from, so shared prefixes are not
+     * searched again. Spur searches are guided by exact distances to the
+     * destination computed once up front. Only the k best candidates are kept.
+     *
+     * As with shortestPath, concurrent queries are safe with one workspace per
+     * thread while nothing mutates the graph.
+     *
+     * @param startLabel The label of the starting airport.
+     * @param endLabel The label of the destination airport.
+     * @param k The maximum number of routes to return.
+     * @param workspace The search state to use for this query.
+     * @param stats Counters to add the work of every search to, or nullptr.
+     * @return std::vector<Route> The routes, shortest first. Empty if no route exists.
+     */
+    std::vector<Route> kShortestPaths(std::string startLabel,
+                                      std::string endLabel, std::size_t k,
+                                      SearchWorkspace &workspace,
+                                      SearchStats *stats = nullptr) const;
+
     /**
      * @brief Gets all vertices in the graph.
-     * @return const std::map<std::string, Vertex *>& A constant reference to the map of vertices.
+     * @return const std::pmr::map<std::string, Vertex *>& A constant reference to the map of vertices.
      */
-    const std::map<std::string, Vertex *> &getVertices() const {
+    const std::pmr::map<std::string, Vertex *> &getVertices() const {
         return vertices;
     }
 
@@ -153,4 +411,8 @@ public:
     std::vector<Edge> getEdges() const;
 };
 
+inline std::string Graph::Edge::getDestinationLabel() const {
+    return destination->label;
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,94 @@
+#ifndef SEARCHSTATS_H
+#define SEARCHSTATS_H
+
+#include <chrono>
+
+/**
+ * @brief Work counters collected by a single shortest path search.
+ *
+ * Pass a pointer to one of these to Graph::shortestPath to find out why a query
+ * was slow. Counting costs one predictable branch per operation when no stats
+ * are requested, and defining FLIGHTPATH_NO_SEARCH_STATS compiles the counting
+ * out entirely, leaving every counter at zero.
+ */
+struct SearchStats {
+    /** Vertices popped with their final distance and expanded. */
+    unsigned long settledVertices = 0;
+    /** Entries pushed onto the priority queue. */
+    unsigned long heapPushes = 0;
+    /** Entries popped from the priority queue. */
+    unsigned long heapPops = 0;
+    /** Popped entries discarded because a shorter distance was already known. */
+    unsigned long staleSkips = 0;
+    /** Edges examined while expanding settled vertices. */
+    unsigned long edgesScanned = 0;
+    /** Edges that improved their destination's tentative distance. */
+    unsigned long edgeRelaxations = 0;
+
+    /**
+     * @brief Whether the counters were compiled in.
+     */
+    static constexpr bool enabled() {
+#ifdef FLIGHTPATH_NO_SEARCH_STATS
+        return false;
+#else
+        return true;
+#endif
+    }
+};
+
+#ifdef FLIGHTPATH_NO_SEARCH_STATS
+#define SEARCH_STATS_ADD(stats, counter, amount) ((void)(stats))
+#else
+#define SEARCH_STATS_ADD(stats, counter, amount)                               \
+    do {                                                                       \
+        if (stats) {                                                           \
+            (stats)->counter += (amount);                                      \
+        }                                                                      \
+    } while (0)
+#endif
+
+/**
+ * @brief Increments a SearchStats counter if stats were requested.
+ */
+#define SEARCH_STATS_INC(stats, counter) SEARCH_STATS_ADD(stats, counter, 1)
+
+/**
+ * @brief Measures how long a phase takes on the monotonic clock.
+ *
+ * The elapsed time in milliseconds is written to the target when the timer
+ * goes out of scope, or earlier if stop() is called.
+ */
+class PhaseTimer {
+public:
+    /**
+     * @brief Starts timing a phase.
+     * @param target Where to store the elapsed milliseconds.
+     */
+    explicit PhaseTimer(double &target)
+        : target(target), start(std::chrono::steady_clock::now()) {}
+
+    ~PhaseTimer() { stop(); }
+
+    PhaseTimer(const PhaseTimer &) = delete;
+    PhaseTimer &operator=(const PhaseTimer &) = delete;
+
+    /**
+     * @brief Stops the timer and records the elapsed time.
+     */
+    void stop() {
+        if (running) {
+            target = std::chrono::duration<double, std::milli>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+            running = false;
+        }
+    }
+
+private:
+    double &target;
+    std::chrono::steady_clock::time_point start;
+    bool running = true;
+};
+
+#endif
@@ -0,0 +1,273 @@
+#ifndef SEARCHWORKSPACE_H
+#define SEARCHWORKSPACE_H
+
+#include "PriorityQueue.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Reusable per-search state for Dijkstra's algorithm over dense vertex ids.
+ *
+ * Distances and predecessors live in flat arrays that are kept between searches.
+ * Instead of refilling them with infinity, each slot carries the epoch of the
+ * search that last wrote it, and starting a new search just bumps the epoch.
+ * A search therefore only pays for the vertices it actually reaches.
+ *
+ * A workspace can also carry masks and potentials that change how the graph
+ * is searched without modifying it. Masked vertices and edges are skipped. The
+ * distances of a finished search can be kept as potentials: exact distances to
+ * a fixed target that guide later searches to it, as in A*.
+ *
+ * A workspace is not thread-safe; give each thread its own.
+ */
+class SearchWorkspace {
+public:
+    /**
+     * @brief The distance of a vertex the current search has not reached.
+     */
+    static constexpr unsigned long INFINITE =
+        std::numeric_limits<unsigned long>::max();
+
+    /**
+     * @brief A priority queue entry: a tentative distance for a vertex.
+     */
+    struct Entry {
+        unsigned long distance;
+        std::size_t vertex;
+
+        bool operator<(const Entry &other) const {
+            return distance < other.distance;
+        }
+
+        bool operator>(const Entry &other) const {
+            return distance > other.distance;
+        }
+    };
+
+    /**
+     * @brief Starts a new search, invalidating every distance from the last one.
+     *
+     * Costs O(1) unless the graph has grown since the last search, in which case
+     * the arrays are extended to the new id bound.
+     *
+     * @param vertexIdBound One more than the largest vertex id in the graph.
+     */
+    void reset(std::size_t vertexIdBound) {
+        if (stamps.size() < vertexIdBound) {
+            stamps.resize(vertexIdBound, 0);
+            distances.resize(vertexIdBound);
+            previous.resize(vertexIdBound);
+        }
+
+        if (++epoch == 0) {
+            wrapEpoch();
+        }
+
+        queue.clear();
+    }
+
+    /**
+     * @brief Fast-forwards the epoch counter so it wraps around within the next
+     * few resets.
+     *
+     * Every stamp goes stale exactly as if that many empty searches had run.
+     * Reaching the wraparound naturally takes 2^32 searches, so tests use this
+     * to exercise it.
+     *
+     * @param searchesLeft How many more resets may run before the wraparound.
+     */
+    void fastForwardEpoch(std::uint32_t searchesLeft) {
+        epoch = std::max(epoch, std::numeric_limits<std::uint32_t>::max() -
+                                    searchesLeft);
+    }
+
+    /**
+     * @brief Gets the tentative distance of a vertex in the current search.
+     * @param v The vertex id.
+     * @return unsigned long The distance, or INFINITE if the vertex is unreached.
+     */
+    unsigned long distance(std::size_t v) const {
+        return stamps[v] == epoch ? distances[v] : INFINITE;
+    }
+
+    /**
+     * @brief Gets the vertex a reached vertex was reached from.
+     * @param v The vertex id, which must have been reached in the current search.
+     * @return std::size_t The predecessor's id.
+     */
+    std::size_t predecessor(std::size_t v) const { return previous[v]; }
+
+    /**
+     * @brief Records a new tentative distance for a vertex.
+     * @param v The vertex id.
+     * @param distance The new distance.
+     * @param from The id of the vertex it was reached from.
+     */
+    void update(std::size_t v, unsigned long distance, std::size_t from) {
+        stamps[v] = epoch;
+        distances[v] = distance;
+        previous[v] = from;
+    }
+
+    /**
+     * @brief Gets the search's priority queue, whose storage is also reused.
+     * @return PriorityQueue<Entry>& The priority queue.
+     */
+    PriorityQueue<Entry> &frontier() { return queue; }
+
+    /**
+     * @brief Keeps the current search's distances and predecessors as potentials.
+     *
+     * The arrays are swapped rather than copied, so this is O(1). The search
+     * must have run to exhaustion from the target, so every vertex that can
+     * reach the target has its exact distance.
+     */
+    void keepAsPotentials() {
+        std::swap(stamps, potentialStamps);
+        std::swap(distances, potentials);
+        std::swap(previous, potentialPrevious);
+        potentialEpoch = epoch;
+    }
+
+    /**
+     * @brief Drops any kept potentials so later searches are unguided.
+     */
+    void clearPotentials() { potentialEpoch = 0; }
+
+    /**
+     * @brief Checks whether potentials are being kept.
+     * @return bool True if searches should be guided by potentials.
+     */
+    bool hasPotentials() const { return potentialEpoch != 0; }
+
+    /**
+     * @brief Gets the kept distance from a vertex to the potentials' target.
+     * @param v The vertex id.
+     * @return unsigned long The distance, or INFINITE if the target is unreachable.
+     */
+    unsigned long potential(std::size_t v) const {
+        return hasPotentials() && v < potentialStamps.size() &&
+                       potentialStamps[v] == potentialEpoch
+                   ? potentials[v]
+                   : INFINITE;
+    }
+
+    /**
+     * @brief Gets the next vertex on a shortest path from a vertex to the
+     * potentials' target.
+     * @param v The vertex id, which must have a finite potential.
+     * @return std::size_t The next vertex's id.
+     */
+    std::size_t potentialNext(std::size_t v) const { return potentialPrevious[v]; }
+
+    /**
+     * @brief Removes every vertex and edge mask.
+     * @param vertexIdBound One more than the largest vertex id in the graph.
+     */
+    void clearMasks(std::size_t vertexIdBound) {
+        if (vertexBans.size() < vertexIdBound) {
+            vertexBans.resize(vertexIdBound, 0);
+            edgeBanSources.resize(vertexIdBound, 0);
+        }
+
+        if (++maskEpoch == 0) {
+            std::fill(vertexBans.begin(), vertexBans.end(), 0);
+            std::fill(edgeBanSources.begin(), edgeBanSources.end(), 0);
+            maskEpoch = 1;
+        }
+
+        bannedEdges.clear();
+        masked = false;
+    }
+
+    /**
+     * @brief Hides a vertex from searches until the masks are cleared.
+     * @param v The vertex id.
+     */
+    void banVertex(std::size_t v) {
+        vertexBans[v] = maskEpoch;
+        masked = true;
+    }
+
+    /**
+     * @brief Hides the edge from one vertex to another until the masks are cleared.
+     * @param from The id of the edge's source.
+     * @param to The id of the edge's destination.
+     */
+    void banEdge(std::size_t from, std::size_t to) {
+        edgeBanSources[from] = maskEpoch;
+        bannedEdges.emplace_back(from, to);
+        masked = true;
+    }
+
+    /**
+     * @brief Checks whether any masks are set.
+     * @return bool True if searches must check masks.
+     */
+    bool hasMasks() const { return masked; }
+
+    /**
+     * @brief Checks whether a vertex is masked.
+     * @param v The vertex id.
+     * @return bool True if the vertex is hidden.
+     */
+    bool vertexBanned(std::size_t v) const {
+        return masked && vertexBans[v] == maskEpoch;
+    }
+
+    /**
+     * @brief Checks whether an edge is masked.
+     * @param from The id of the edge's source.
+     * @param to The id of the edge's destination.
+     * @return bool True if the edge is hidden.
+     */
+    bool edgeBanned(std::size_t from, std::size_t to) const {
+        if (!masked || edgeBanSources[from] != maskEpoch) {
+            return false;
+        }
+        return std::find(bannedEdges.begin(), bannedEdges.end(),
+                         std::make_pair(from, to)) != bannedEdges.end();
+    }
+
+private:
+    /**
+     * @brief Restarts the epoch counter after it wraps around to zero.
+     *
+     * Both stamp arrays share one counter. The search stamps are cleared, and
+     * kept potentials are re-stamped as epoch 1 so a wraparound in the middle
+     * of a guided query does not lose them. Searches resume at epoch 2.
+     */
+    void wrapEpoch() {
+        std::fill(stamps.begin(), stamps.end(), 0);
+        for (auto &stamp : potentialStamps) {
+            stamp = hasPotentials() && stamp == potentialEpoch ? 1 : 0;
+        }
+        if (hasPotentials()) {
+            potentialEpoch = 1;
+        }
+        epoch = 2;
+    }
+
+    std::uint32_t epoch = 0;
+    std::vector<std::uint32_t> stamps;
+    std::vector<unsigned long> distances;
+    std::vector<std::size_t> previous;
+    PriorityQueue<Entry> queue;
+
+    std::uint32_t potentialEpoch = 0;
+    std::vector<std::uint32_t> potentialStamps;
+    std::vector<unsigned long> potentials;
+    std::vector<std::size_t> potentialPrevious;
+
+    bool masked = false;
+    std::uint32_t maskEpoch = 0;
+    std::vector<std::uint32_t> vertexBans;
+    std::vector<std::uint32_t> edgeBanSources;
+    std::vector<std::pair<std::size_t, std::size_t>> bannedEdges;
+};
+
+#endif
@@ -1,9 +1,11 @@
 #ifndef FILEIO_H
 #define FILEIO_H
 
+#include "AirportTable.h"
 #include "Graph.h"
 
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <sstream>
 #include <string>
@@ -22,6 +24,35 @@
  */
 std::unordered_map<std::string, std::string> loadAirportCodeMapCSV();
 
+/**
+ * @brief Opens the 'airports.csv' file as a memory-mapped airport index.
+ *
+ * This looks for 'airports.csv' in the same places as loadAirportCodeMapCSV, but
+ * instead of copying every row into a map it indexes the mapped file directly.
+ * Code lookups are O(1) and names are only resolved for the airports that are
+ * actually printed.
+ *
+ * @return AirportTable The airport index.
+ */
+AirportTable loadAirportTable();
+
+/**
+ * @brief Streams the flights in a CSV file to a callback, one row at a time.
+ *
+ * Each row is expected to follow the 'FlightConnectionsJan2025.csv' schema: origin,
+ * destination, two elapsed-time columns, and distance. The header row and rows
+ * missing an origin, destination or distance are skipped. No rows are retained,
+ * so arbitrarily large files can be scanned in constant memory.
+ *
+ * @param file_path The path to the CSV file containing flight data.
+ * @param visit Called with the origin code, destination code and distance of
+ *        each flight.
+ */
+void forEachFlightCSV(
+    std::string file_path,
+    const std::function<void(const std::string &, const std::string &,
+                             unsigned long)> &visit);
+
 /**
  * @brief Loads flight data from a CSV file into a Graph data structure.
  *
@@ -0,0 +1,79 @@
+#include "../include/AirportTable.h"
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+AirportTable::AirportTable(const std::string &file_path)
+    : nameOffsets(SLOT_COUNT, 0) {
+  int fd = open(file_path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open airport data at " + file_path);
+  }
+
+  struct stat info;
+  if (fstat(fd, &info) != 0) {
+    close(fd);
+    throw std::runtime_error("Failed to read airport data at " + file_path);
+  }
+
+  size = static_cast<std::size_t>(info.st_size);
+  if (size > 0) {
+    void *mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapped == MAP_FAILED) {
+      close(fd);
+      throw std::runtime_error("Failed to map airport data at " + file_path);
+    }
+    data = static_cast<const char *>(mapped);
+  }
+  close(fd);
+
+  std::size_t line_start = 0;
+  while (line_start < size) {
+    const void *newline =
+        std::memchr(data + line_start, '\n', size - line_start);
+    std::size_t line_end =
+        newline ? static_cast<const char *>(newline) - data : size;
+
+    if (line_end - line_start > 4 && data[line_start + 3] == ',') {
+      long index = slot(std::string_view(data + line_start, 3));
+      if (index >= 0) {
+        nameOffsets[index] = static_cast<std::uint32_t>(line_start + 4 + 1);
+      }
+    }
+
+    line_start = line_end + 1;
+  }
+}
+
+AirportTable::~AirportTable() {
+  if (data) {
+    munmap(const_cast<char *>(data), size);
+  }
+}
+
+AirportTable::AirportTable(AirportTable &&other) noexcept
+    : data(other.data), size(other.size),
+      nameOffsets(std::move(other.nameOffsets)) {
+  other.data = nullptr;
+  other.size = 0;
+}
+
+bool AirportTable::contains(std::string_view code) const {
+  long index = slot(code);
+  return index >= 0 && nameOffsets[index] != 0;
+}
+
+std::string_view AirportTable::name(std::string_view code) const {
+  long index = slot(code);
+  if (index < 0 || nameOffsets[index] == 0) {
+    return {};
+  }
+
+  std::size_t start = nameOffsets[index] - 1;
+  const void *newline = std::memchr(data + start, '\n', size - start);
+  std::size_t end = newline ? static_cast<const char *>(newline) - data : size;
+  return std::string_view(data + start, end - start);
+}
@@ -0,0 +1,40 @@
+#include "../include/CompactGraph.h"
+
+AnyCompactGraph makeCompactGraph(const Graph &graph, VertexOrder order) {
+  std::size_t vertexCount = graph.getVertices().size();
+  unsigned long maxWeight = 0;
+  for (const auto &[label, vertex] : graph.getVertices()) {
+    for (const auto &edge : vertex->edges) {
+      maxWeight = std::max(maxWeight, edge.distance);
+    }
+  }
+
+  using Narrow = CompactGraph<std::uint16_t, std::uint16_t>;
+  using WideIds = CompactGraph<std::uint16_t, std::uint32_t>;
+  using WideWeights = CompactGraph<std::uint32_t, std::uint16_t>;
+  using Wide = CompactGraph<std::uint32_t, std::uint32_t>;
+
+  if (Narrow::fits(vertexCount, maxWeight)) {
+    return Narrow(graph, order);
+  }
+  if (WideIds::fits(vertexCount, maxWeight)) {
+    return WideIds(graph, order);
+  }
+  if (WideWeights::fits(vertexCount, maxWeight)) {
+    return WideWeights(graph, order);
+  }
+  if (Wide::fits(vertexCount, maxWeight)) {
+    return Wide(graph, order);
+  }
+
+  throw std::runtime_error("Flight network is too large for a compact graph");
+}
+
+unsigned long compactShortestPath(const AnyCompactGraph &graph,
+                                  const std::string &startLabel,
+                                  const std::string &endLabel,
+                                  std::vector<std::string> &path) {
+  return std::visit(
+      [&](const auto &g) { return g.shortestPath(startLabel, endLabel, path); },
+      graph);
+}
@@ -0,0 +1,177 @@
+#include "../include/CompressedGraph.h"
+#include "../include/PriorityQueue.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+
+struct CompressedNode {
+  std::uint64_t distance;
+  std::uint32_t vertex;
+
+  bool operator<(const CompressedNode &other) const {
+    return distance < other.distance;
+  }
+
+  bool operator>(const CompressedNode &other) const {
+    return distance > other.distance;
+  }
+};
+
+void writeVarint(std::vector<std::uint8_t> &out, std::uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<std::uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<std::uint8_t>(value));
+}
+
+std::uint64_t readVarint(const std::uint8_t *&in) {
+  std::uint64_t value = 0;
+  int shift = 0;
+  while (*in & 0x80) {
+    value |= static_cast<std::uint64_t>(*in++ & 0x7f) << shift;
+    shift += 7;
+  }
+  value |= static_cast<std::uint64_t>(*in++) << shift;
+  return value;
+}
+
+std::uint64_t zigzag(std::int64_t value) {
+  return (static_cast<std::uint64_t>(value) << 1) ^
+         static_cast<std::uint64_t>(value >> 63);
+}
+
+std::int64_t unzigzag(std::uint64_t value) {
+  return static_cast<std::int64_t>(value >> 1) ^
+         -static_cast<std::int64_t>(value & 1);
+}
+
+} // namespace
+
+CompressedGraph::CompressedGraph(const Graph &graph) {
+  const auto &vertices = graph.getVertices();
+
+  std::unordered_map<const Graph::Vertex *, std::uint32_t> ids;
+  ids.reserve(vertices.size());
+  labels.reserve(vertices.size());
+  for (const auto &[label, vertex] : vertices) {
+    ids.emplace(vertex, static_cast<std::uint32_t>(labels.size()));
+    labels.push_back(label);
+  }
+
+  rowOffsets.reserve(vertices.size() + 1);
+  std::vector<std::pair<std::uint32_t, unsigned long>> row;
+  std::uint32_t u = 0;
+  for (const auto &[label, vertex] : vertices) {
+    rowOffsets.push_back(static_cast<std::uint32_t>(bytes.size()));
+
+    row.clear();
+    for (const auto &edge : vertex->edges) {
+      row.emplace_back(ids.at(edge.destination), edge.distance);
+    }
+    std::sort(row.begin(), row.end());
+
+    writeVarint(bytes, row.size());
+    std::int64_t previous = u;
+    bool first = true;
+    for (const auto &[target, weight] : row) {
+      if (first) {
+        writeVarint(bytes, zigzag(static_cast<std::int64_t>(target) - previous));
+        first = false;
+      } else {
+        writeVarint(bytes, static_cast<std::uint64_t>(target - previous));
+      }
+      writeVarint(bytes, weight);
+      previous = target;
+    }
+
+    edges += row.size();
+    u++;
+  }
+  rowOffsets.push_back(static_cast<std::uint32_t>(bytes.size()));
+
+  if (bytes.size() > std::numeric_limits<std::uint32_t>::max()) {
+    throw std::runtime_error("Graph is too large to compress");
+  }
+  bytes.shrink_to_fit();
+}
+
+long CompressedGraph::findVertex(const std::string &label) const {
+  auto it = std::lower_bound(labels.begin(), labels.end(), label);
+  if (it == labels.end() || *it != label) {
+    return -1;
+  }
+  return static_cast<long>(it - labels.begin());
+}
+
+unsigned long CompressedGraph::shortestPath(const std::string &startLabel,
+                                            const std::string &endLabel,
+                                            std::vector<std::string> &path) const {
+  path.clear();
+
+  long start = findVertex(startLabel);
+  long end = findVertex(endLabel);
+  if (start < 0 || end < 0) {
+    return std::numeric_limits<unsigned long>::max();
+  }
+
+  const std::uint64_t infinity = std::numeric_limits<std::uint64_t>::max();
+  std::vector<std::uint64_t> distances(labels.size(), infinity);
+  std::vector<std::uint32_t> previous(labels.size());
+
+  distances[start] = 0;
+
+  PriorityQueue<CompressedNode> pq;
+  pq.push({0, static_cast<std::uint32_t>(start)});
+
+  while (!pq.isEmpty()) {
+    CompressedNode current = pq.top();
+    pq.pop();
+
+    std::uint32_t u = current.vertex;
+    if (current.distance > distances[u]) {
+      continue;
+    }
+
+    if (u == static_cast<std::uint32_t>(end)) {
+      break;
+    }
+
+    const std::uint8_t *in = bytes.data() + rowOffsets[u];
+    std::uint64_t degree = readVarint(in);
+    std::int64_t v = u;
+    for (std::uint64_t i = 0; i < degree; i++) {
+      if (i == 0) {
+        v += unzigzag(readVarint(in));
+      } else {
+        v += static_cast<std::int64_t>(readVarint(in));
+      }
+      std::uint64_t candidate = distances[u] + readVarint(in);
+
+      if (candidate < distances[v]) {
+        distances[v] = candidate;
+        previous[v] = u;
+        pq.push({candidate, static_cast<std::uint32_t>(v)});
+      }
+    }
+  }
+
+  if (distances[end] == infinity) {
+    return std::numeric_limits<unsigned long>::max();
+  }
+
+  for (std::uint32_t curr = static_cast<std::uint32_t>(end);;
+       curr = previous[curr]) {
+    path.push_back(labels[curr]);
+    if (curr == static_cast<std::uint32_t>(start)) {
+      break;
+    }
+  }
+  std::reverse(path.begin(), path.end());
+
+  return static_cast<unsigned long>(distances[end]);
+}
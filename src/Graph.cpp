@@ -1,41 +1,108 @@
 #include "../include/Graph.h"
 #include "../include/PriorityQueue.h"
 #include <algorithm>
+#include <iterator>
 #include <limits>
+#include <new>
+#include <set>
+#include <unordered_set>
 
-// Helper struct for Dijkstra's Priority Queue
-// Must define comparison operators for the custom PriorityQueue to work
-struct DijkstraNode {
-  unsigned long distance;
-  std::string vertexLabel;
+Graph::Graph() : Graph(std::pmr::new_delete_resource()) {}
 
-  // Overload < operator for Min-Heap logic
-  // The PriorityQueue is a Min-Heap based on value, so we want smaller distance
-  // to be "smaller"
-  bool operator<(const DijkstraNode &other) const {
-    return distance < other.distance;
+Graph::Graph(std::pmr::memory_resource *upstream)
+    : pool(std::make_unique<std::pmr::unsynchronized_pool_resource>(upstream)),
+      vertices(pool.get()) {}
+
+Graph::~Graph() { clearGraph(); }
+
+Graph::Graph(Graph &&other) noexcept
+    : pool(std::move(other.pool)), vertices(std::move(other.vertices)),
+      verticesById(std::move(other.verticesById)),
+      freeIds(std::move(other.freeIds)),
+      ownWorkspace(std::move(other.ownWorkspace)),
+      componentsStale(other.componentsStale), heapLabels(other.heapLabels) {
+  other.vertices.clear();
+  other.verticesById.clear();
+  other.freeIds.clear();
+}
+
+Graph &Graph::operator=(Graph &&other) noexcept {
+  if (this != &other) {
+    clearGraph();
+    // A pmr map keeps its own allocator on move assignment and would copy the
+    // nodes into our pool, so rebuild it on top of the incoming pool instead.
+    vertices.~VertexIndex();
+    ::new (&vertices) VertexIndex(std::move(other.vertices));
+    verticesById = std::move(other.verticesById);
+    freeIds = std::move(other.freeIds);
+    ownWorkspace = std::move(other.ownWorkspace);
+    pool = std::move(other.pool);
+    heapLabels = other.heapLabels;
+    componentsStale = other.componentsStale;
+    other.vertices.clear();
+    other.verticesById.clear();
+    other.freeIds.clear();
   }
+  return *this;
+}
+
+void Graph::clearGraph() {
+  verticesById.clear();
+  freeIds.clear();
+  componentsStale = false;
 
-  // Overload > operator because the heap implementation might use it
-  bool operator>(const DijkstraNode &other) const {
-    return distance > other.distance;
+  // A moved-from graph has no pool and nothing left to free.
+  if (!pool) {
+    return;
   }
-};
 
-Graph::Graph() {}
+  if (heapLabels) {
+    // Some labels live on the global heap, so every string must be destroyed.
+    for (auto &pair : vertices) {
+      pair.second->~Vertex();
+    }
+    vertices.clear();
+  } else {
+    // Vertices, edges and index nodes own nothing outside the pool, so skip
+    // their destructors and start a fresh index; release() reclaims them all.
+    ::new (&vertices) VertexIndex(pool.get());
+  }
+  heapLabels = false;
 
-Graph::~Graph() { clearGraph(); }
+  // Hand the pool's chunks back to the upstream resource in one go.
+  pool->release();
+}
 
-void Graph::clearGraph() {
-  for (auto &pair : vertices) {
-    delete pair.second;
+Graph::Vertex *Graph::createVertex(std::string label) {
+  std::pmr::polymorphic_allocator<Vertex> alloc(pool.get());
+  Vertex *v = alloc.allocate(1);
+  alloc.construct(v, std::move(label), pool.get());
+  if (v->label.size() > std::string().capacity()) {
+    heapLabels = true;
+  }
+
+  if (freeIds.empty()) {
+    v->id = verticesById.size();
+    verticesById.push_back(v);
+  } else {
+    v->id = freeIds.back();
+    freeIds.pop_back();
+    verticesById[v->id] = v;
   }
-  vertices.clear();
+  return v;
+}
+
+void Graph::destroyVertex(Vertex *v) {
+  std::pmr::polymorphic_allocator<Vertex> alloc(pool.get());
+  verticesById[v->id] = nullptr;
+  freeIds.push_back(v->id);
+  v->~Vertex();
+  alloc.deallocate(v, 1);
 }
 
 void Graph::addVertex(std::string label) {
   if (vertices.find(label) == vertices.end()) {
-    vertices[label] = new Vertex(label);
+    vertices[label] = createVertex(label);
   }
 }
 
@@ -45,16 +112,45 @@ void Graph::removeVertex(std::string label) {
     return;
   }
 
-  for (auto &pair : vertices) {
-    Vertex *v = pair.second;
-    v->edges.remove_if(
-        [&label](const Edge &e) { return e.destinationLabel == label; });
+  Vertex *v = it->second;
+  for (const auto &edge : v->edges) {
+    edge.destination->edges.erase(edge.twin);
+  }
+  if (!v->edges.empty()) {
+    componentsStale = true;
   }
 
-  delete it->second;
+  destroyVertex(v);
   vertices.erase(it);
 }
 
+void Graph::removeVertices(const std::vector<std::string> &labels) {
+  std::unordered_set<Vertex *> doomed;
+  doomed.reserve(labels.size());
+  for (const auto &label : labels) {
+    auto it = vertices.find(label);
+    if (it != vertices.end()) {
+      doomed.insert(it->second);
+    }
+  }
+
+  for (Vertex *v : doomed) {
+    for (const auto &edge : v->edges) {
+      if (doomed.find(edge.destination) == doomed.end()) {
+        edge.destination->edges.erase(edge.twin);
+      }
+    }
+    if (!v->edges.empty()) {
+      componentsStale = true;
+    }
+  }
+
+  for (Vertex *v : doomed) {
+    vertices.erase(v->label);
+    destroyVertex(v);
+  }
+}
+
 void Graph::addEdge(std::string label1, std::string label2,
                     unsigned long distance) {
   auto it1 = vertices.find(label1);
@@ -71,28 +167,34 @@ void Graph::addEdge(std::string label1, std::string label2,
   Vertex *v1 = it1->second;
   Vertex *v2 = it2->second;
 
-  auto edge_it1 =
+  // Both directions always exist together, so searching the shorter list is
+  // enough to find the pair.
+  if (v2->edges.size() < v1->edges.size()) {
+    std::swap(v1, v2);
+  }
+
+  auto edge_it =
       std::find_if(v1->edges.begin(), v1->edges.end(),
-                   [&](const Edge &e) { return e.destinationLabel == label2; });
+                   [&](const Edge &e) { return e.destination == v2; });
 
-  if (edge_it1 != v1->edges.end()) {
-    if (distance < edge_it1->distance) {
-      edge_it1->distance = distance;
+  if (edge_it != v1->edges.end()) {
+    if (distance < edge_it->distance) {
+      edge_it->distance = distance;
+      edge_it->twin->distance = distance;
     }
-  } else {
-    v1->edges.push_back(Edge(label2, distance));
+    return;
   }
 
-  auto edge_it2 =
-      std::find_if(v2->edges.begin(), v2->edges.end(),
-                   [&](const Edge &e) { return e.destinationLabel == label1; });
+  auto forward = v1->edges.insert(v1->edges.end(), Edge(v2, distance));
+  auto backward = v2->edges.insert(v2->edges.end(), Edge(v1, distance));
 
-  if (edge_it2 != v2->edges.end()) {
-    if (distance < edge_it2->distance) {
-      edge_it2->distance = distance;
-    }
-  } else {
-    v2->edges.push_back(Edge(label1, distance));
+  forward->twin = backward;
+  backward->twin = forward;
+
+  // A stale index may still point at removed vertices; the rebuild will pick
+  // this edge up instead.
+  if (!componentsStale) {
+    unionComponents(v1, v2);
   }
 }
 
@@ -107,79 +209,347 @@ void Graph::removeEdge(std::string label1, std::string label2) {
   Vertex *v1 = it1->second;
   Vertex *v2 = it2->second;
 
-  v1->edges.remove_if(
-      [&label2](const Edge &e) { return e.destinationLabel == label2; });
+  if (v2->edges.size() < v1->edges.size()) {
+    std::swap(v1, v2);
+  }
+
+  auto edge_it =
+      std::find_if(v1->edges.begin(), v1->edges.end(),
+                   [&](const Edge &e) { return e.destination == v2; });
+
+  if (edge_it != v1->edges.end()) {
+    v2->edges.erase(edge_it->twin);
+    v1->edges.erase(edge_it);
+    componentsStale = true;
+  }
+}
+
+Graph::Vertex *Graph::findComponent(Vertex *v) {
+  while (v->componentParent != v) {
+    v = v->componentParent;
+  }
+  return v;
+}
+
+void Graph::unionComponents(Vertex *a, Vertex *b) {
+  Vertex *rootA = findComponent(a);
+  Vertex *rootB = findComponent(b);
+  if (rootA == rootB) {
+    return;
+  }
+
+  if (rootA->componentRank < rootB->componentRank) {
+    std::swap(rootA, rootB);
+  }
+  rootB->componentParent = rootA;
+  if (rootA->componentRank == rootB->componentRank) {
+    rootA->componentRank++;
+  }
+}
+
+void Graph::rebuildComponents() {
+  for (auto &pair : vertices) {
+    pair.second->componentParent = pair.second;
+    pair.second->componentRank = 0;
+  }
+
+  for (auto &pair : vertices) {
+    Vertex *v = pair.second;
+    for (const auto &edge : v->edges) {
+      unionComponents(v, edge.destination);
+    }
+  }
+
+  componentsStale = false;
+}
+
+bool Graph::connected(std::string label1, std::string label2) {
+  auto it1 = vertices.find(label1);
+  auto it2 = vertices.find(label2);
+
+  if (it1 == vertices.end() || it2 == vertices.end()) {
+    return false;
+  }
 
-  v2->edges.remove_if(
-      [&label1](const Edge &e) { return e.destinationLabel == label1; });
+  if (componentsStale) {
+    rebuildComponents();
+  }
+
+  return findComponent(it1->second) == findComponent(it2->second);
 }
 
 unsigned long Graph::shortestPath(std::string startLabel, std::string endLabel,
                                   std::vector<std::string> &path) {
+  return shortestPath(startLabel, endLabel, path, nullptr);
+}
+
+unsigned long Graph::shortestPath(std::string startLabel, std::string endLabel,
+                                  std::vector<std::string> &path,
+                                  SearchStats *stats) {
+  if (!connected(startLabel, endLabel)) {
+    path.clear();
+    return UNREACHABLE;
+  }
+
+  return shortestPath(startLabel, endLabel, path, ownWorkspace, stats);
+}
+
+unsigned long Graph::shortestPath(std::string startLabel, std::string endLabel,
+                                  std::vector<std::string> &path,
+                                  SearchWorkspace &workspace,
+                                  SearchStats *stats) const {
   path.clear();
 
-  if (vertices.find(startLabel) == vertices.end() ||
-      vertices.find(endLabel) == vertices.end()) {
-    return std::numeric_limits<unsigned long>::max();
+  auto start_it = vertices.find(startLabel);
+  auto end_it = vertices.find(endLabel);
+  if (start_it == vertices.end() || end_it == vertices.end()) {
+    return UNREACHABLE;
   }
 
-  std::map<std::string, unsigned long> distances;
-  std::map<std::string, std::string> previous;
+  std::size_t start = start_it->second->id;
+  std::size_t end = end_it->second->id;
 
-  for (auto const &[label, vertex] : vertices) {
-    distances[label] = std::numeric_limits<unsigned long>::max();
+  if (!componentsStale &&
+      findComponent(start_it->second) != findComponent(end_it->second)) {
+    return UNREACHABLE;
   }
 
-  distances[startLabel] = 0;
+  if (search(start, end, workspace, false, stats) == SearchWorkspace::INFINITE) {
+    return UNREACHABLE;
+  }
+
+  for (std::size_t curr = end;; curr = workspace.predecessor(curr)) {
+    path.push_back(verticesById[curr]->label);
+    if (curr == start) {
+      break;
+    }
+  }
+  std::reverse(path.begin(), path.end());
+
+  return workspace.distance(end);
+}
+
+unsigned long Graph::search(std::size_t start, std::size_t end,
+                            SearchWorkspace &workspace, bool guided,
+                            SearchStats *stats) const {
+  workspace.reset(verticesById.size());
+  auto &pq = workspace.frontier();
+
+  auto estimate = [&](std::size_t v) {
+    return guided ? workspace.potential(v) : 0UL;
+  };
+
+  if (workspace.vertexBanned(start) ||
+      estimate(start) == SearchWorkspace::INFINITE) {
+    return SearchWorkspace::INFINITE;
+  }
 
-  PriorityQueue<DijkstraNode> pq;
-  pq.push({0, startLabel});
+  workspace.update(start, 0, start);
+  pq.push({estimate(start), start});
+  SEARCH_STATS_INC(stats, heapPushes);
 
   while (!pq.isEmpty()) {
-    DijkstraNode current = pq.top();
+    SearchWorkspace::Entry current = pq.top();
     pq.pop();
+    SEARCH_STATS_INC(stats, heapPops);
 
-    std::string uLabel = current.vertexLabel;
-    unsigned long uDist = current.distance;
-
-    if (uDist > distances[uLabel]) {
+    unsigned long uDist = workspace.distance(current.vertex);
+    if (current.distance > uDist + estimate(current.vertex)) {
+      SEARCH_STATS_INC(stats, staleSkips);
       continue;
     }
 
-    if (uLabel == endLabel) {
+    SEARCH_STATS_INC(stats, settledVertices);
+
+    if (current.vertex == end) {
       break;
     }
 
-    Vertex *uVertex = vertices[uLabel];
+    const Vertex *uVertex = verticesById[current.vertex];
+    SEARCH_STATS_ADD(stats, edgesScanned, uVertex->edges.size());
 
     for (const auto &edge : uVertex->edges) {
-      std::string vLabel = edge.destinationLabel;
-      unsigned long distance = edge.distance;
+      std::size_t v = edge.destination->id;
 
-      if (distances[uLabel] != std::numeric_limits<unsigned long>::max() &&
-          distances[uLabel] + distance < distances[vLabel]) {
+      if (workspace.hasMasks() && (workspace.vertexBanned(v) ||
+                                   workspace.edgeBanned(current.vertex, v))) {
+        continue;
+      }
+
+      unsigned long remaining = estimate(v);
+      if (remaining == SearchWorkspace::INFINITE) {
+        continue;
+      }
 
-        distances[vLabel] = distances[uLabel] + distance;
-        previous[vLabel] = uLabel;
+      unsigned long candidate = uDist + edge.distance;
 
-        pq.push({distances[vLabel], vLabel});
+      if (candidate < workspace.distance(v)) {
+        workspace.update(v, candidate, current.vertex);
+
+        pq.push({candidate + remaining, v});
+        SEARCH_STATS_INC(stats, edgeRelaxations);
+        SEARCH_STATS_INC(stats, heapPushes);
       }
     }
   }
 
-  if (distances[endLabel] == std::numeric_limits<unsigned long>::max()) {
-    return std::numeric_limits<unsigned long>::max();
+  return end < verticesById.size() ? workspace.distance(end)
+                                   : SearchWorkspace::INFINITE;
+}
+
+std::vector<Graph::Route> Graph::kShortestPaths(std::string startLabel,
+                                                std::string endLabel,
+                                                std::size_t k) {
+  if (!connected(startLabel, endLabel)) {
+    return {};
   }
 
-  std::string curr = endLabel;
-  while (curr != startLabel) {
-    path.push_back(curr);
-    curr = previous[curr];
+  return kShortestPaths(startLabel, endLabel, k, ownWorkspace, nullptr);
+}
+
+namespace {
+
+// A loopless route by vertex id, with the distance travelled on reaching each
+// vertex so any prefix's length can be read off without a search.
+struct IdRoute {
+  std::vector<std::size_t> vertices;
+  std::vector<unsigned long> reached;
+  std::size_t deviation = 0;
+
+  unsigned long distance() const { return reached.back(); }
+
+  bool operator<(const IdRoute &other) const {
+    if (distance() != other.distance()) {
+      return distance() < other.distance();
+    }
+    return vertices < other.vertices;
+  }
+};
+
+} // namespace
+
+std::vector<Graph::Route> Graph::kShortestPaths(std::string startLabel,
+                                                std::string endLabel,
+                                                std::size_t k,
+                                                SearchWorkspace &workspace,
+                                                SearchStats *stats) const {
+  std::vector<Route> routes;
+
+  auto start_it = vertices.find(startLabel);
+  auto end_it = vertices.find(endLabel);
+  if (k == 0 || start_it == vertices.end() || end_it == vertices.end()) {
+    return routes;
+  }
+
+  std::size_t start = start_it->second->id;
+  std::size_t end = end_it->second->id;
+
+  if (!componentsStale &&
+      findComponent(start_it->second) != findComponent(end_it->second)) {
+    return routes;
+  }
+
+  // One exhaustive search back from the destination gives every vertex its
+  // exact remaining distance. Masks only ever lengthen routes, so those
+  // distances stay admissible and steer each spur search straight to the end.
+  workspace.clearMasks(verticesById.size());
+  search(end, std::numeric_limits<std::size_t>::max(), workspace, false, stats);
+  workspace.keepAsPotentials();
+
+  if (workspace.potential(start) == SearchWorkspace::INFINITE) {
+    workspace.clearPotentials();
+    return routes;
+  }
+
+  std::vector<IdRoute> accepted;
+  {
+    IdRoute first;
+    for (std::size_t curr = start;; curr = workspace.potentialNext(curr)) {
+      first.vertices.push_back(curr);
+      first.reached.push_back(workspace.potential(start) -
+                              workspace.potential(curr));
+      if (curr == end) {
+        break;
+      }
+    }
+    accepted.push_back(std::move(first));
+  }
+
+  // Only the k - |accepted| best candidates can still make the cut, so the
+  // candidate set is trimmed to that size as it grows.
+  std::set<IdRoute> candidates;
+
+  while (accepted.size() < k) {
+    const IdRoute &last = accepted.back();
+
+    // Spurs before the point where this route left its parent were already
+    // explored when the parent was accepted.
+    for (std::size_t i = last.deviation; i + 1 < last.vertices.size(); i++) {
+      std::size_t spur = last.vertices[i];
+
+      workspace.clearMasks(verticesById.size());
+      for (std::size_t j = 0; j < i; j++) {
+        workspace.banVertex(last.vertices[j]);
+      }
+      for (const auto &route : accepted) {
+        if (route.vertices.size() > i + 1 &&
+            std::equal(route.vertices.begin(), route.vertices.begin() + i + 1,
+                       last.vertices.begin())) {
+          workspace.banEdge(spur, route.vertices[i + 1]);
+        }
+      }
+
+      if (search(spur, end, workspace, true, stats) ==
+          SearchWorkspace::INFINITE) {
+        continue;
+      }
+
+      IdRoute candidate;
+      candidate.deviation = i;
+      candidate.vertices.assign(last.vertices.begin(),
+                                last.vertices.begin() + i);
+      candidate.reached.assign(last.reached.begin(), last.reached.begin() + i);
+
+      std::size_t spurStart = candidate.vertices.size();
+      for (std::size_t curr = end;; curr = workspace.predecessor(curr)) {
+        candidate.vertices.push_back(curr);
+        candidate.reached.push_back(last.reached[i] + workspace.distance(curr));
+        if (curr == spur) {
+          break;
+        }
+      }
+      std::reverse(candidate.vertices.begin() + spurStart,
+                   candidate.vertices.end());
+      std::reverse(candidate.reached.begin() + spurStart,
+                   candidate.reached.end());
+
+      candidates.insert(std::move(candidate));
+      if (candidates.size() > k - accepted.size()) {
+        candidates.erase(std::prev(candidates.end()));
+      }
+    }
+
+    if (candidates.empty()) {
+      break;
+    }
+
+    accepted.push_back(std::move(candidates.extract(candidates.begin()).value()));
+  }
+
+  workspace.clearMasks(verticesById.size());
+  workspace.clearPotentials();
+
+  routes.reserve(accepted.size());
+  for (const auto &route : accepted) {
+    Route labelled;
+    labelled.distance = route.distance();
+    for (std::size_t v : route.vertices) {
+      labelled.airports.push_back(verticesById[v]->label);
+    }
+    routes.push_back(std::move(labelled));
   }
-  path.push_back(startLabel);
-  std::reverse(path.begin(), path.end());
 
-  return distances[endLabel];
+  return routes;
 }
 
 std::vector<Graph::Edge> Graph::getEdges() const {
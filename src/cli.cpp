@@ -5,7 +5,10 @@
 
 void print_usage() {
   std::cout << "Usage: ./flightpath --source <source_airport> --destination "
-               "<destination_airport> --flight-data <flight_data_csv>"
+               "<destination_airport> --flight-data <flight_data_csv> [--stats]"
+            << std::endl;
+  std::cout << "  --stats  print search counters and phase timings as JSON "
+               "to standard error"
             << std::endl;
 }
 
@@ -15,7 +18,7 @@ void parse_args(int argc, char **argv) {
     print_usage();
     exit(0);
   }
-  if (argc != 7) {
+  if (argc != 7 && argc != 8) {
     throw std::runtime_error(
         "Invalid number of arguments\n"
         "Please define -s (source airport), -d (destination airport), and -f "
@@ -42,5 +45,10 @@ void parse_args(int argc, char **argv) {
         "Please define -s (source airport), -d (destination airport), and -f "
         "(flight data path)\n"
         "For help, run ./flightpath --help");
+  } else if (argc == 8 && std::string(argv[7]) != "--stats") {
+    throw std::runtime_error(
+        "Invalid argument\n"
+        "The only optional flag is --stats\n"
+        "For help, run ./flightpath --help");
   }
 }
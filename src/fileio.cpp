@@ -27,8 +27,22 @@ std::unordered_map<std::string, std::string> loadAirportCodeMapCSV() {
   return database;
 }
 
-Graph loadFlightsCSV(std::string file_path) {
-  Graph flight_graph;
+AirportTable loadAirportTable() {
+  for (const char *path : {"airports.csv", "assets/airports.csv"}) {
+    if (std::ifstream(path).is_open()) {
+      return AirportTable(path);
+    }
+  }
+
+  throw std::runtime_error(
+      "Failed to load airport code data"
+      "\nPlease make sure airports.csv is accessible to the executable");
+}
+
+void forEachFlightCSV(
+    std::string file_path,
+    const std::function<void(const std::string &, const std::string &,
+                             unsigned long)> &visit) {
   std::ifstream flight_data{file_path};
 
   if (!flight_data) {
@@ -56,12 +70,20 @@ Graph loadFlightsCSV(std::string file_path) {
     if (origin.empty() || dest.empty() || dist.empty())
       continue;
 
-    unsigned long dist_ul = std::stoul(dist);
+    visit(origin, dest, std::stoul(dist));
+  }
+}
+
+Graph loadFlightsCSV(std::string file_path) {
+  Graph flight_graph;
 
+  forEachFlightCSV(file_path, [&](const std::string &origin,
+                                  const std::string &dest,
+                                  unsigned long dist_ul) {
     flight_graph.addVertex(origin);
     flight_graph.addVertex(dest);
     flight_graph.addEdge(origin, dest, dist_ul);
-  }
+  });
 
   return flight_graph;
 }
\ No newline at end of file
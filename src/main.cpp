@@ -1,9 +1,49 @@
 #include "../include/Graph.h"
+#include "../include/SearchStats.h"
 #include "../include/cli.h"
 #include "../include/fileio.h"
 #include <iostream>
 #include <string>
 
+/**
+ * @brief Times of the phases of a single run, in milliseconds.
+ */
+struct PhaseTimes {
+  double airportData = 0;
+  double flightData = 0;
+  double search = 0;
+};
+
+/**
+ * @brief Writes a run's phase timings and search counters as one JSON object.
+ */
+void print_stats_json(std::ostream &out, const std::string &source,
+                      const std::string &destination, unsigned long distance,
+                      const PhaseTimes &phases, const SearchStats &stats) {
+  bool reachable = distance != Graph::UNREACHABLE;
+
+  out << "{\"source\": \"" << source << "\", \"destination\": \""
+      << destination << "\", \"reachable\": " << (reachable ? "true" : "false")
+      << ", \"distance\": ";
+  if (reachable) {
+    out << distance;
+  } else {
+    out << "null";
+  }
+  out << ", \"phases_ms\": {\"airport_data\": " << phases.airportData
+      << ", \"flight_data\": " << phases.flightData
+      << ", \"search\": " << phases.search << "}"
+      << ", \"search\": {\"counters_enabled\": "
+      << (SearchStats::enabled() ? "true" : "false")
+      << ", \"settled_vertices\": " << stats.settledVertices
+      << ", \"heap_pushes\": " << stats.heapPushes
+      << ", \"heap_pops\": " << stats.heapPops
+      << ", \"stale_skips\": " << stats.staleSkips
+      << ", \"edges_scanned\": " << stats.edgesScanned
+      << ", \"edge_relaxations\": " << stats.edgeRelaxations << "}}"
+      << std::endl;
+}
+
 int main(int argc, char *argv[]) {
 
   try {
@@ -15,6 +55,10 @@ int main(int argc, char *argv[]) {
 
   std::string user_source{argv[2]}, user_destination{argv[4]},
       flights_csv{argv[6]};
+  bool print_stats = argc == 8;
+
+  PhaseTimes phases;
+  SearchStats search_stats;
 
   if (user_source.length() > 3 || user_source.length() < 3) {
     std::cerr << "Invalid source format\nPlease use the Buearu of "
@@ -35,28 +79,35 @@ int main(int argc, char *argv[]) {
 
   std::cout << "Reading from flight data...\n";
 
-  auto airportMap = loadAirportCodeMapCSV();
+  PhaseTimer airport_timer(phases.airportData);
+  auto airports = loadAirportTable();
+  airport_timer.stop();
 
-  if (airportMap.find(user_source) == airportMap.end()) {
+  if (!airports.contains(user_source)) {
     std::cerr << "Source '" << user_source
               << "' not found\nPlease try another airport code\n";
     return 0;
   }
-  if (airportMap.find(user_destination) == airportMap.end()) {
+  if (!airports.contains(user_destination)) {
     std::cerr << "Destination '" << user_destination
               << "' not found\nPlease try another airport code\n";
     return 0;
   }
 
+  PhaseTimer flight_timer(phases.flightData);
   Graph flight_graph = loadFlightsCSV(flights_csv);
+  flight_timer.stop();
 
   std::vector<std::string> flight_route;
 
+  PhaseTimer search_timer(phases.search);
   auto route_dist =
-      flight_graph.shortestPath(user_source, user_destination, flight_route);
+      flight_graph.shortestPath(user_source, user_destination, flight_route,
+                                print_stats ? &search_stats : nullptr);
+  search_timer.stop();
 
   std::cout << "Shortest Flight Route:\n\n";
-  if (route_dist > 15000) {
+  if (route_dist == Graph::UNREACHABLE) {
 
     std::cout
         << "It looks like you chose two airports that are not connected! \n"
@@ -66,13 +117,8 @@ int main(int argc, char *argv[]) {
   } else {
 
     std::cout << "The closest route between\n"
-              << (airportMap.find(user_source) != airportMap.end()
-                      ? airportMap[user_source]
-                      : user_source)
-              << " and "
-              << (airportMap.find(user_destination) != airportMap.end()
-                      ? airportMap[user_destination]
-                      : user_destination)
+              << airports.name(user_source) << " and "
+              << airports.name(user_destination)
               << " is:\n";
     std::cout << '\n';
 
@@ -87,5 +133,10 @@ int main(int argc, char *argv[]) {
     std::cout << "Total distance: " << route_dist << " miles\n";
   }
 
+  if (print_stats) {
+    print_stats_json(std::cerr, user_source, user_destination, route_dist,
+                     phases, search_stats);
+  }
+
   return 0;
 }
@@ -1,8 +1,55 @@
 #define CATCH_CONFIG_MAIN
 
 #include "../external/catch2/catch_amalgamated.hpp"
+#include "../include/CompactGraph.h"
+#include "../include/CompressedGraph.h"
 #include "../include/fileio.h"
 
+#include <algorithm>
+#include <functional>
+#include <set>
+#include <utility>
+
+namespace {
+
+// Spreads origin/destination pairs over every airport in a graph, visiting
+// every `step`-th airport as an origin so large networks stay quick to test.
+std::vector<std::pair<std::string, std::string>>
+sampleAirportPairs(const Graph &graph, std::size_t step) {
+  std::vector<std::string> labels;
+  for (const auto &[label, vertex] : graph.getVertices()) {
+    labels.push_back(label);
+  }
+
+  std::vector<std::pair<std::string, std::string>> pairs;
+  for (std::size_t i = 0; i < labels.size(); i += step) {
+    pairs.emplace_back(labels[i], labels[(i * 31 + 5) % labels.size()]);
+  }
+  return pairs;
+}
+
+// Adds up a route's flight distances from the graph's own edges, so routes
+// found by other engines can be checked without assuming they are unique.
+unsigned long routeDistance(const Graph &graph,
+                            const std::vector<std::string> &route) {
+  unsigned long total = 0;
+  for (std::size_t i = 1; i < route.size(); i++) {
+    unsigned long leg = std::numeric_limits<unsigned long>::max();
+    for (const auto &edge : graph.getVertices().at(route[i - 1])->edges) {
+      if (edge.getDestinationLabel() == route[i]) {
+        leg = std::min(leg, edge.distance);
+      }
+    }
+    if (leg == std::numeric_limits<unsigned long>::max()) {
+      return leg;
+    }
+    total += leg;
+  }
+  return total;
+}
+
+} // namespace
+
 // TEST_CASE("Graph ADT", "[basic operations]") {
 
 //   REQUIRE(1 == 1); // not implemented yet so it fails.
@@ -69,3 +116,375 @@ TEST_CASE("test", "[mock graph used]") {
   REQUIRE(dist == 9);
   REQUIRE(shortest_route == std::vector<std::string>{"A", "B", "C", "E"});
 }
+
+TEST_CASE("Arena backed graph", "[mock graph used]") {
+
+  std::pmr::monotonic_buffer_resource arena;
+  Graph arena_graph(&arena);
+
+  arena_graph.addVertex("A");
+  arena_graph.addVertex("B");
+  arena_graph.addVertex("C");
+
+  arena_graph.addEdge("A", "B", 5);
+  arena_graph.addEdge("B", "C", 7);
+
+  arena_graph.removeVertex("B");
+  REQUIRE(arena_graph.getVertices().size() == 2);
+  REQUIRE(arena_graph.getEdges().empty());
+
+  arena_graph.addVertex("B");
+  arena_graph.addEdge("A", "B", 5);
+  arena_graph.addEdge("B", "C", 7);
+
+  auto shortest_route{std::vector<std::string>()};
+  auto dist = arena_graph.shortestPath("A", "C", shortest_route);
+
+  REQUIRE(dist == 12);
+  REQUIRE(shortest_route == std::vector<std::string>{"A", "B", "C"});
+
+  Graph moved_graph = std::move(arena_graph);
+  REQUIRE(moved_graph.getVertices().size() == 3);
+  REQUIRE(moved_graph.shortestPath("C", "A", shortest_route) == 12);
+
+  // Labels too long for the small-string buffer live on the heap and must
+  // still be freed when the pool is released.
+  Graph long_labels;
+  long_labels.addVertex("Los Angeles International");
+  long_labels.addVertex("John F. Kennedy International");
+  long_labels.addEdge("Los Angeles International",
+                      "John F. Kennedy International", 2475);
+
+  moved_graph = std::move(long_labels);
+  REQUIRE(moved_graph.getVertices().size() == 2);
+  REQUIRE(moved_graph.shortestPath("John F. Kennedy International",
+                                   "Los Angeles International",
+                                   shortest_route) == 2475);
+}
+
+TEST_CASE("Removing airports and flights", "[test file used]") {
+
+  auto flightsNetwork = loadFlightsCSV("./assets/flights-test-data.csv");
+  auto shortest_route{std::vector<std::string>()};
+
+  flightsNetwork.removeEdge("DEN", "LAX");
+  REQUIRE(flightsNetwork.shortestPath("LAX", "SUN", shortest_route) == 400);
+
+  flightsNetwork.removeVertex("SUN");
+  REQUIRE(flightsNetwork.getVertices().count("SUN") == 0);
+  for (const auto &edge : flightsNetwork.getEdges()) {
+    REQUIRE(edge.getDestinationLabel() != "SUN");
+  }
+
+  flightsNetwork.removeVertices({"JFK", "DEN", "XXX"});
+  REQUIRE(flightsNetwork.getVertices().size() == 1);
+  REQUIRE(flightsNetwork.getEdges().empty());
+}
+
+TEST_CASE("Airport table lookups", "[airport data used]") {
+
+  auto airportMap = loadAirportCodeMapCSV();
+  auto airports = loadAirportTable();
+
+  for (const auto &[code, name] : airportMap) {
+    if (AirportTable::slot(code) >= 0) {
+      REQUIRE(airports.contains(code));
+      REQUIRE(airports.name(code) == name);
+    }
+  }
+
+  REQUIRE(airports.name("JFK") == "John F. Kennedy International Airport");
+  REQUIRE_FALSE(airports.contains("ZZZ"));
+  REQUIRE_FALSE(airports.contains("jfk"));
+  REQUIRE_FALSE(airports.contains("Code"));
+  REQUIRE(airports.name("ZZZ").empty());
+}
+
+TEST_CASE("Compact graph matches Graph", "[flight data used]") {
+
+  auto flightsNetwork =
+      loadFlightsCSV("./assets/FlightConnectionsJan2025.csv");
+  auto compact = makeCompactGraph(flightsNetwork);
+
+  REQUIRE(std::holds_alternative<CompactGraph<std::uint16_t, std::uint16_t>>(
+      compact));
+
+  std::vector<std::string> route, compact_route;
+  for (const auto &[from, to] : sampleAirportPairs(flightsNetwork, 7)) {
+    auto dist = flightsNetwork.shortestPath(from, to, route);
+    REQUIRE(compactShortestPath(compact, from, to, compact_route) == dist);
+    if (dist != std::numeric_limits<unsigned long>::max()) {
+      REQUIRE(compact_route.front() == from);
+      REQUIRE(compact_route.back() == to);
+    }
+  }
+
+  CompactGraph<std::uint16_t, std::uint16_t, HopMetric> hops(flightsNetwork);
+  REQUIRE(hops.shortestPath("JFK", "LAX", compact_route) == 1);
+  REQUIRE(compact_route == std::vector<std::string>{"JFK", "LAX"});
+  REQUIRE(hops.shortestPath("JFK", "ZZZ", compact_route) ==
+          std::numeric_limits<unsigned long>::max());
+}
+
+TEST_CASE("Reordered compact graphs agree", "[flight data used]") {
+
+  auto flightsNetwork =
+      loadFlightsCSV("./assets/FlightConnectionsJan2025.csv");
+  auto by_label = makeCompactGraph(flightsNetwork, VertexOrder::Label);
+  auto hub_first = makeCompactGraph(flightsNetwork, VertexOrder::HubFirst);
+  auto rcm = makeCompactGraph(flightsNetwork, VertexOrder::ReverseCuthillMcKee);
+
+  const auto &hubs = std::get<CompactGraph<std::uint16_t, std::uint16_t>>(hub_first);
+  REQUIRE(hubs.findVertex("DEN") >= 0);
+  REQUIRE(hubs.label(hubs.findVertex("DEN")) == "DEN");
+  REQUIRE(hubs.findVertex("ZZZ") == -1);
+
+  // Tied routes can differ between numberings, so each route is checked
+  // against the graph rather than against the others.
+  std::vector<std::string> route, hub_route, rcm_route;
+  for (const auto &[from, to] : sampleAirportPairs(flightsNetwork, 5)) {
+    auto dist = compactShortestPath(by_label, from, to, route);
+    REQUIRE(compactShortestPath(hub_first, from, to, hub_route) == dist);
+    REQUIRE(compactShortestPath(rcm, from, to, rcm_route) == dist);
+    if (dist == std::numeric_limits<unsigned long>::max()) {
+      continue;
+    }
+    for (const auto *found : {&route, &hub_route, &rcm_route}) {
+      REQUIRE(found->front() == from);
+      REQUIRE(found->back() == to);
+      REQUIRE(routeDistance(flightsNetwork, *found) == dist);
+    }
+  }
+}
+
+TEST_CASE("Compressed graph matches Graph", "[flight data used]") {
+
+  auto flightsNetwork =
+      loadFlightsCSV("./assets/FlightConnectionsJan2025.csv");
+  CompressedGraph compressed(flightsNetwork);
+  CompactGraph<std::uint16_t, std::uint16_t> compact(flightsNetwork);
+
+  REQUIRE(compressed.vertexCount() == flightsNetwork.getVertices().size());
+  REQUIRE(compressed.edgeCount() == flightsNetwork.getEdges().size());
+  REQUIRE(compressed.memoryBytes() < compact.memoryBytes());
+
+  std::vector<std::string> route, compressed_route;
+  for (const auto &[from, to] : sampleAirportPairs(flightsNetwork, 3)) {
+    auto dist = flightsNetwork.shortestPath(from, to, route);
+    REQUIRE(compressed.shortestPath(from, to, compressed_route) == dist);
+    if (!route.empty()) {
+      REQUIRE(compressed_route.front() == from);
+      REQUIRE(compressed_route.back() == to);
+    }
+  }
+
+  REQUIRE(compressed.shortestPath("LAX", "ZZZ", compressed_route) ==
+          std::numeric_limits<unsigned long>::max());
+  REQUIRE(compressed_route.empty());
+}
+
+TEST_CASE("Search statistics", "[test file used]") {
+
+  auto flightsNetwork = loadFlightsCSV("./assets/flights-test-data.csv");
+
+  auto shortest_route{std::vector<std::string>()};
+  SearchStats stats;
+  auto dist = flightsNetwork.shortestPath("LAX", "SUN", shortest_route, &stats);
+
+  REQUIRE(dist == 170);
+  if (!SearchStats::enabled()) {
+    REQUIRE(stats.heapPushes == 0);
+    return;
+  }
+  REQUIRE(stats.heapPops == stats.settledVertices + stats.staleSkips);
+  REQUIRE(stats.heapPushes == stats.edgeRelaxations + 1);
+  REQUIRE(stats.edgeRelaxations <= stats.edgesScanned);
+  REQUIRE(stats.settledVertices >= 3);
+
+  SearchStats unreachable;
+  flightsNetwork.shortestPath("LAX", "ZZZ", shortest_route, &unreachable);
+  REQUIRE(unreachable.heapPushes == 0);
+}
+
+TEST_CASE("Connected components", "[mock graph used]") {
+
+  Graph islands;
+
+  for (auto label : {"A", "B", "C", "X", "Y"}) {
+    islands.addVertex(label);
+  }
+
+  islands.addEdge("A", "B", 10);
+  islands.addEdge("B", "C", 10);
+  islands.addEdge("X", "Y", 10);
+
+  auto shortest_route{std::vector<std::string>()};
+  SearchStats stats;
+  REQUIRE(islands.shortestPath("A", "Y", shortest_route, &stats) ==
+          Graph::UNREACHABLE);
+  REQUIRE(shortest_route.empty());
+  REQUIRE(stats.heapPushes == 0);
+  REQUIRE(islands.connected("A", "C"));
+  REQUIRE_FALSE(islands.connected("C", "X"));
+
+  islands.addEdge("C", "X", 10);
+  REQUIRE(islands.shortestPath("A", "Y", shortest_route) == 40);
+
+  islands.removeEdge("B", "C");
+  REQUIRE_FALSE(islands.connected("A", "Y"));
+  REQUIRE(islands.connected("C", "Y"));
+
+  islands.removeVertex("B");
+  islands.addEdge("A", "Y", 5);
+  REQUIRE(islands.shortestPath("A", "C", shortest_route) == 25);
+
+  islands.removeVertices({"Y", "X"});
+  REQUIRE_FALSE(islands.connected("A", "C"));
+  REQUIRE_FALSE(islands.connected("A", "ZZZ"));
+}
+
+TEST_CASE("Reusable search workspace", "[flight data used]") {
+
+  auto flightsNetwork =
+      loadFlightsCSV("./assets/FlightConnectionsJan2025.csv");
+  const Graph &shared = flightsNetwork;
+
+  const std::size_t airports = flightsNetwork.getVertices().size();
+
+  SearchWorkspace reused;
+  std::vector<std::string> route, fresh_route;
+  for (const auto &[from, to] : sampleAirportPairs(flightsNetwork, 3)) {
+    SearchWorkspace fresh;
+    auto dist = shared.shortestPath(from, to, route, reused);
+    REQUIRE(shared.shortestPath(from, to, fresh_route, fresh) == dist);
+    REQUIRE(route == fresh_route);
+  }
+
+  flightsNetwork.removeVertex("DEN");
+  flightsNetwork.addVertex("QQQ");
+  flightsNetwork.addVertex("QQR");
+  flightsNetwork.addEdge("QQQ", "JFK", 10);
+  flightsNetwork.addEdge("QQR", "QQQ", 10);
+  REQUIRE(flightsNetwork.vertexIdBound() == airports + 1);
+
+  REQUIRE(shared.shortestPath("QQR", "JFK", route, reused) == 20);
+  REQUIRE(route == std::vector<std::string>{"QQR", "QQQ", "JFK"});
+  REQUIRE(shared.shortestPath("QQR", "DEN", route, reused) ==
+          Graph::UNREACHABLE);
+}
+
+TEST_CASE("Search workspace epoch wraparound", "[mock graph used]") {
+
+  SearchWorkspace workspace;
+  workspace.reset(4);
+  workspace.update(0, 0, 0);
+  workspace.update(1, 5, 0);
+  workspace.keepAsPotentials();
+
+  workspace.fastForwardEpoch(0);
+  workspace.reset(4);
+  REQUIRE(workspace.hasPotentials());
+  REQUIRE(workspace.potential(1) == 5);
+  REQUIRE(workspace.potential(3) == SearchWorkspace::INFINITE);
+  REQUIRE(workspace.distance(1) == SearchWorkspace::INFINITE);
+
+  workspace.clearPotentials();
+  REQUIRE(workspace.potential(1) == SearchWorkspace::INFINITE);
+  workspace.fastForwardEpoch(0);
+  workspace.reset(4);
+  REQUIRE_FALSE(workspace.hasPotentials());
+  REQUIRE(workspace.potential(1) == SearchWorkspace::INFINITE);
+  REQUIRE(workspace.potential(3) == SearchWorkspace::INFINITE);
+
+  // Move the wraparound through every search a k shortest routes query runs.
+  auto flightsNetwork = loadFlightsCSV("./assets/flights-test-data.csv");
+  const Graph &shared = flightsNetwork;
+  SearchWorkspace fresh;
+  auto expected = shared.kShortestPaths("LAX", "SUN", 3, fresh);
+  REQUIRE(expected.size() == 3);
+
+  for (std::uint32_t searchesLeft = 0; searchesLeft < 32; searchesLeft++) {
+    SearchWorkspace wrapping;
+    wrapping.fastForwardEpoch(searchesLeft);
+    auto routes = shared.kShortestPaths("LAX", "SUN", 3, wrapping);
+    REQUIRE(routes.size() == expected.size());
+    for (std::size_t i = 0; i < routes.size(); i++) {
+      REQUIRE(routes[i].distance == expected[i].distance);
+      REQUIRE(routes[i].airports == expected[i].airports);
+    }
+  }
+}
+
+TEST_CASE("K shortest routes", "[test file used]") {
+
+  auto flightsNetwork = loadFlightsCSV("./assets/flights-test-data.csv");
+
+  auto routes = flightsNetwork.kShortestPaths("LAX", "SUN", 5);
+
+  REQUIRE(routes.size() == 3);
+  REQUIRE(routes[0].distance == 170);
+  REQUIRE(routes[0].airports == std::vector<std::string>{"LAX", "DEN", "SUN"});
+  REQUIRE(routes[1].distance == 400);
+  REQUIRE(routes[1].airports == std::vector<std::string>{"LAX", "SUN"});
+  REQUIRE(routes[2].distance == 668);
+  REQUIRE(routes[2].airports == std::vector<std::string>{"LAX", "JFK", "SUN"});
+
+  REQUIRE(flightsNetwork.kShortestPaths("LAX", "SUN", 1).size() == 1);
+  REQUIRE(flightsNetwork.kShortestPaths("LAX", "ZZZ", 3).empty());
+  REQUIRE(flightsNetwork.getEdges().size() == 10);
+}
+
+TEST_CASE("K shortest routes match brute force", "[mock graph used]") {
+
+  Graph grid;
+  std::vector<std::string> labels;
+  for (int i = 0; i < 9; i++) {
+    labels.push_back(std::string(1, static_cast<char>('A' + i)));
+    grid.addVertex(labels.back());
+  }
+  for (int i = 0; i < 9; i++) {
+    for (int j = i + 1; j < 9; j++) {
+      if ((i * 7 + j * 3) % 4 != 0) {
+        grid.addEdge(labels[i], labels[j], 10 + (i * 13 + j * 29) % 50);
+      }
+    }
+  }
+
+  // Every loopless route from A to I, found by depth-first search.
+  std::vector<unsigned long> all_distances;
+  std::vector<std::string> stack{"A"};
+  std::function<void(unsigned long)> explore = [&](unsigned long so_far) {
+    if (stack.back() == "I") {
+      all_distances.push_back(so_far);
+      return;
+    }
+    for (const auto &edge : grid.getVertices().at(stack.back())->edges) {
+      if (std::find(stack.begin(), stack.end(), edge.getDestinationLabel()) ==
+          stack.end()) {
+        stack.push_back(edge.getDestinationLabel());
+        explore(so_far + edge.distance);
+        stack.pop_back();
+      }
+    }
+  };
+  explore(0);
+  std::sort(all_distances.begin(), all_distances.end());
+
+  SearchWorkspace workspace;
+  const Graph &shared = grid;
+  for (std::size_t k : {1, 3, 10, 20}) {
+    auto routes = shared.kShortestPaths("A", "I", k, workspace);
+    REQUIRE(routes.size() == std::min(k, all_distances.size()));
+    for (std::size_t i = 0; i < routes.size(); i++) {
+      REQUIRE(routes[i].distance == all_distances[i]);
+      REQUIRE(routes[i].airports.front() == "A");
+      REQUIRE(routes[i].airports.back() == "I");
+      std::set<std::string> unique(routes[i].airports.begin(),
+                                   routes[i].airports.end());
+      REQUIRE(unique.size() == routes[i].airports.size());
+    }
+  }
+
+  std::vector<std::string> path;
+  REQUIRE(shared.shortestPath("A", "I", path, workspace) == all_distances[0]);
+}